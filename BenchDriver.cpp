@@ -0,0 +1,369 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// BenchDriver.cpp
+//*********************************************************
+// Purpose: Benchmark driver for the storage layer.
+// For each data size N it fills a scratch directory with N
+// vessels, sailings, vehicles and reservations, then times
+// the control-level operations (createReservation,
+// deleteReservation, checkIn, querySailing,
+// printSailingReport, printAuditReport on one thread and on
+// every core, deleteSailing) and prints one CSV row per
+// operation with ops/sec and latency percentiles.
+//
+// Usage: bench [-o ops] [-d dir] [N ...]
+//   -o ops  timed calls per operation (default 1000)
+//   -d dir  scratch directory (default bench_data)
+//   N ...   data sizes (default 100 1000 10000); sizes up
+//           to 1000000 are supported but take a while to fill
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, printAuditReport
+//*********************************************************
+
+#include "Util.h"
+#include "OtherControls.h"
+#include "SailingControl.h"
+#include "Reservation.h"
+#include "Sailing.h"
+#include "Vehicle.h"
+#include "Vessel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Length of a regular vehicle in decimetres, as used by
+// createReservation
+static const int BENCH_VEHICLE_LENGTH = 70;
+// Height of a regular vehicle in decimetres
+static const int BENCH_VEHICLE_HEIGHT = 20;
+// Number of times the whole report is generated
+static const int REPORT_RUNS = 3;
+
+//*********************************************************
+// Stream buffer that discards everything written to it,
+// used to silence the controls while they are timed
+//*********************************************************
+class NullBuffer : public streambuf
+{
+protected:
+    int overflow(int c) override
+    {
+        return c;
+    }
+};
+
+//*********************************************************
+// Formats an ID as prefix followed by a zero-padded number
+//*********************************************************
+static string numbered(const string &prefix, int n, int width)
+{
+    char digits[16];
+    snprintf(digits, sizeof(digits), "%0*d", width, n);
+    return prefix + digits;
+}
+
+//*********************************************************
+// Builds the i-th unique sailing ID (aaa-dd-hh). Hours vary
+// fastest, then days, then the terminal letters.
+//*********************************************************
+static string sailingIdFor(int i)
+{
+    int hour = i % 24;
+    int day = (i / 24) % 31 + 1;
+    int terminal = i / (24 * 31);
+
+    char id[16];
+    snprintf(id, sizeof(id), "%c%c%c-%02d-%02d",
+             'a' + terminal / (26 * 26) % 26,
+             'a' + terminal / 26 % 26,
+             'a' + terminal % 26, day, hour);
+    return id;
+}
+
+//*********************************************************
+// Latency samples for one operation, in microseconds
+//*********************************************************
+struct Timings
+{
+    vector<double> samples;
+    double totalSeconds = 0;
+
+    //*********************************************************
+    // Times a single call of op
+    //*********************************************************
+    template <typename Op>
+    void time(Op op)
+    {
+        auto start = chrono::steady_clock::now();
+        op();
+        auto end = chrono::steady_clock::now();
+        double seconds =
+            chrono::duration<double>(end - start).count();
+        samples.push_back(seconds * 1e6);
+        totalSeconds += seconds;
+    }
+
+    //*********************************************************
+    // Nearest-rank percentile of the samples
+    //*********************************************************
+    double percentile(double p)
+    {
+        if (samples.empty())
+        {
+            return 0;
+        }
+        sort(samples.begin(), samples.end());
+        size_t rank = static_cast<size_t>(
+            p / 100.0 * samples.size() + 0.5);
+        rank = min(max(rank, static_cast<size_t>(1)),
+                   samples.size());
+        return samples[rank - 1];
+    }
+};
+
+//*********************************************************
+// Prints one CSV result row
+//*********************************************************
+static void printRow(ostream &out, int n, const string &name,
+                     Timings &t)
+{
+    double opsPerSec = t.totalSeconds > 0
+                        ? t.samples.size() / t.totalSeconds : 0;
+    out << n << "," << name << "," << t.samples.size() << ","
+        << fixed << opsPerSec << ","
+        << t.percentile(50) << ","
+        << t.percentile(95) << ","
+        << t.percentile(99) << endl;
+    out.unsetf(ios::floatfield);
+}
+
+//*********************************************************
+// Fills the data files with n of each record type. Sailing
+// i runs on vessel i and carries the reservation of vehicle
+// i, so every sailing starts with one booked vehicle.
+// The extra bench vehicles used by createReservation are
+// written here as well so no prompt is raised while timing.
+//*********************************************************
+static void fill(int n, int ops)
+{
+    for (int i = 0; i < n; i++)
+    {
+        string vesselName = numbered("Vessel", i, 7);
+        Vessel::writeVessel(vesselName, 3600, 3600);
+
+        string sailingId = sailingIdFor(i);
+        Sailing::writeSailing(sailingId, vesselName, 
+                        3600 * Util::DECIMETRES_PER_METRE,
+                        3600 * Util::DECIMETRES_PER_METRE);
+
+        string license = numbered("L", i, 7);
+        Vehicle::writeVehicle(license, "6045550100",
+                              BENCH_VEHICLE_HEIGHT,
+                              BENCH_VEHICLE_LENGTH);
+
+        int remainingHRL, remainingLRL;
+        Sailing::tryReserveSpace(sailingId, BENCH_VEHICLE_LENGTH,
+                                 false, remainingHRL,
+                                 remainingLRL);
+        Reservation::writeReservation(license, sailingId);
+    }
+
+    for (int i = 0; i < ops; i++)
+    {
+        Vehicle::writeVehicle(numbered("B", i, 7), "6045550199",
+                              BENCH_VEHICLE_HEIGHT,
+                              BENCH_VEHICLE_LENGTH);
+    }
+}
+
+//*********************************************************
+// Runs every benchmark for one data size
+//*********************************************************
+static void runSize(int n, int ops, ostream &out)
+{
+    // Start from empty data, index and log files
+    for (const auto &entry : filesystem::directory_iterator("."))
+    {
+        string extension = entry.path().extension().string();
+        if (extension == ".dat" || extension == ".idx"
+            || extension == ".wal")
+        {
+            filesystem::remove(entry.path());
+        }
+    }
+
+    Util::startup();
+    fill(n, ops);
+
+    mt19937 random(static_cast<unsigned int>(n));
+    uniform_int_distribution<int> anySailing(0, n - 1);
+
+    // Sailing each bench vehicle is booked on
+    vector<string> bookedOn(ops);
+    for (int i = 0; i < ops; i++)
+    {
+        bookedOn[i] = sailingIdFor(anySailing(random));
+    }
+
+    Timings create, checkIn, remove, query, report, deleteSail;
+    Timings auditSerial, auditParallel;
+    int cores = max(1u, thread::hardware_concurrency());
+    string phone = "6045550199";
+
+    for (int i = 0; i < ops; i++)
+    {
+        string license = numbered("B", i, 7);
+        create.time([&]() {
+            OtherControls::createReservation(phone, bookedOn[i],
+                                             license);
+        });
+    }
+
+    for (int i = 0; i < ops; i++)
+    {
+        string license = numbered("B", i, 7);
+        checkIn.time([&]() {
+            OtherControls::checkIn(license, bookedOn[i]);
+        });
+    }
+
+    for (int i = 0; i < ops; i++)
+    {
+        string license = numbered("B", i, 7);
+        remove.time([&]() {
+            OtherControls::deleteReservation(license, bookedOn[i]);
+        });
+    }
+
+    for (int i = 0; i < ops; i++)
+    {
+        string sailingId = sailingIdFor(anySailing(random));
+        query.time([&]() {
+            SailingControl::querySailing(sailingId);
+        });
+    }
+
+    // Answer yes to every "Show more sailings?" page prompt
+    string allPages;
+    for (int page = 0; page < n / 5 + 1; page++)
+    {
+        allPages += "y\n";
+    }
+    for (int run = 0; run < REPORT_RUNS; run++)
+    {
+        istringstream answers(allPages);
+        streambuf *oldIn = cin.rdbuf(answers.rdbuf());
+        report.time([&]() {
+            SailingControl::printSailingReport();
+        });
+        cin.rdbuf(oldIn);
+    }
+
+    for (int run = 0; run < REPORT_RUNS; run++)
+    {
+        auditSerial.time([&]() {
+            SailingControl::printAuditReport(cout, 1);
+        });
+        if (cores > 1)
+        {
+            auditParallel.time([&]() {
+                SailingControl::printAuditReport(cout, cores);
+            });
+        }
+    }
+
+    // Delete distinct sailings, confirming each prompt
+    vector<int> order(n);
+    for (int i = 0; i < n; i++)
+    {
+        order[i] = i;
+    }
+    shuffle(order.begin(), order.end(), random);
+    for (int i = 0; i < min(ops, n); i++)
+    {
+        string sailingId = sailingIdFor(order[i]);
+        istringstream answer("y\n");
+        streambuf *oldIn = cin.rdbuf(answer.rdbuf());
+        deleteSail.time([&]() {
+            SailingControl::deleteSailing(sailingId);
+        });
+        cin.rdbuf(oldIn);
+    }
+
+    Util::shutdown();
+
+    printRow(out, n, "createReservation", create);
+    printRow(out, n, "checkIn", checkIn);
+    printRow(out, n, "deleteReservation", remove);
+    printRow(out, n, "querySailing", query);
+    printRow(out, n, "printSailingReport", report);
+    printRow(out, n, "printAuditReport/1", auditSerial);
+    if (cores > 1)
+    {
+        printRow(out, n, "printAuditReport/" + to_string(cores),
+                auditParallel);
+    }
+    printRow(out, n, "deleteSailing", deleteSail);
+}
+
+int main(int argc, char *argv[])
+{
+    int ops = 1000;
+    string directory = "bench_data";
+    vector<int> sizes;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc)
+        {
+            ops = atoi(argv[++i]);
+        }
+        else if (arg == "-d" && i + 1 < argc)
+        {
+            directory = argv[++i];
+        }
+        else if (atoi(argv[i]) > 0)
+        {
+            sizes.push_back(atoi(argv[i]));
+        }
+        else
+        {
+            cerr << "Usage: bench [-o ops] [-d dir] [N ...]"
+                 << endl;
+            return 1;
+        }
+    }
+    if (sizes.empty())
+    {
+        sizes = {100, 1000, 10000};
+    }
+
+    filesystem::create_directories(directory);
+    filesystem::current_path(directory);
+
+    // Results go to the real stdout; everything the controls
+    // print while being timed is discarded
+    ostream out(cout.rdbuf());
+    NullBuffer nullBuffer;
+    cout.rdbuf(&nullBuffer);
+
+    out << "n,operation,ops,ops_per_sec,p50_us,p95_us,p99_us"
+        << endl;
+    for (int n : sizes)
+    {
+        runSize(n, ops, out);
+    }
+
+    cout.rdbuf(out.rdbuf());
+    return 0;
+}
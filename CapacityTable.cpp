@@ -0,0 +1,264 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// CapacityTable.cpp
+//*********************************************************
+// Purpose: Implements the in-memory lane capacity table and
+// its write-back thread.
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, sync with other processes
+// Oct 17, 2026 Version 3 - Team 18, keyed by sailing key
+// Oct 17, 2026 Version 4 - Team 18, flushNow
+// Oct 17, 2026 Version 5 - Team 18, one batch at a time
+//*********************************************************
+
+#include "CapacityTable.h"
+#include <chrono>
+
+using namespace std;
+
+//*********************************************************
+// clear()
+//*********************************************************
+void CapacityTable::clear()
+{
+    unique_lock<shared_mutex> lock(tableLock);
+    table.clear();
+
+    lock_guard<mutex> dirty(dirtyLock);
+    dirtyKeys.clear();
+}
+
+//*********************************************************
+// set()
+//*********************************************************
+void CapacityTable::set(uint32_t sailingKey, int high,
+                        int low)
+{
+    unique_lock<shared_mutex> lock(tableLock);
+    unique_ptr<Lanes> &lanes = table[sailingKey];
+    if (!lanes)
+    {
+        lanes.reset(new Lanes());
+        lanes->dirty = false;
+    }
+    lanes->high = high;
+    lanes->low = low;
+    lanes->baseHigh = high;
+    lanes->baseLow = low;
+}
+
+//*********************************************************
+// remove()
+//*********************************************************
+void CapacityTable::remove(uint32_t sailingKey)
+{
+    // A queued write-back finds the sailing gone and skips it
+    unique_lock<shared_mutex> lock(tableLock);
+    table.erase(sailingKey);
+}
+
+//*********************************************************
+// get()
+//*********************************************************
+bool CapacityTable::get(uint32_t sailingKey, int &high,
+                        int &low) const
+{
+    shared_lock<shared_mutex> lock(tableLock);
+    auto entry = table.find(sailingKey);
+    if (entry == table.end())
+    {
+        return false;
+    }
+
+    high = entry->second->high.load();
+    low = entry->second->low.load();
+    return true;
+}
+
+//*********************************************************
+// tryTake()
+// Compare-and-swap loop: the deduction only lands if the
+// lane did not change since it was checked.
+//*********************************************************
+bool CapacityTable::tryTake(uint32_t sailingKey,
+                            bool highLane, int needed,
+                            int amount, int &high, int &low)
+{
+    shared_lock<shared_mutex> lock(tableLock);
+    auto entry = table.find(sailingKey);
+    if (entry == table.end())
+    {
+        return false;
+    }
+
+    Lanes &lanes = *entry->second;
+    atomic<int> &lane = highLane ? lanes.high : lanes.low;
+    int current = lane.load();
+    do
+    {
+        if (current < needed)
+        {
+            high = lanes.high.load();
+            low = lanes.low.load();
+            return false;
+        }
+    }
+    while (!lane.compare_exchange_weak(current, current - amount));
+
+    markDirty(sailingKey, lanes);
+    high = lanes.high.load();
+    low = lanes.low.load();
+    return true;
+}
+
+//*********************************************************
+// add()
+//*********************************************************
+bool CapacityTable::add(uint32_t sailingKey, bool highLane,
+                        int amount, int &high, int &low)
+{
+    shared_lock<shared_mutex> lock(tableLock);
+    auto entry = table.find(sailingKey);
+    if (entry == table.end())
+    {
+        return false;
+    }
+
+    Lanes &lanes = *entry->second;
+    (highLane ? lanes.high : lanes.low).fetch_add(amount);
+
+    markDirty(sailingKey, lanes);
+    high = lanes.high.load();
+    low = lanes.low.load();
+    return true;
+}
+
+//*********************************************************
+// sync()
+//*********************************************************
+bool CapacityTable::sync(uint32_t sailingKey, int &diskHigh,
+                        int &diskLow)
+{
+    shared_lock<shared_mutex> lock(tableLock);
+    auto entry = table.find(sailingKey);
+    if (entry == table.end())
+    {
+        return false;
+    }
+
+    Lanes &lanes = *entry->second;
+    lanes.high.fetch_add(diskHigh - lanes.baseHigh.load());
+    lanes.low.fetch_add(diskLow - lanes.baseLow.load());
+
+    diskHigh = lanes.high.load();
+    diskLow = lanes.low.load();
+    lanes.baseHigh = diskHigh;
+    lanes.baseLow = diskLow;
+    return true;
+}
+
+//*********************************************************
+// markDirty()
+// Queues a sailing for write-back the first time it changes
+// since its last write
+//*********************************************************
+void CapacityTable::markDirty(uint32_t sailingKey,
+                                Lanes &lanes)
+{
+    if (!lanes.dirty.exchange(true))
+    {
+        lock_guard<mutex> lock(dirtyLock);
+        dirtyKeys.push_back(sailingKey);
+    }
+}
+
+//*********************************************************
+// flush()
+// Writes back every queued sailing. Each call takes its own
+// batch, so a flushNow racing the flusher never writes the
+// same queued sailing twice, and waits for the batch before
+// it, so it never returns while one is half written.
+//*********************************************************
+void CapacityTable::flush()
+{
+    lock_guard<mutex> flushing(flushLock);
+    vector<uint32_t> batch;
+    {
+        lock_guard<mutex> lock(dirtyLock);
+        batch.swap(dirtyKeys);
+    }
+
+    for (uint32_t sailingKey : batch)
+    {
+        {
+            shared_lock<shared_mutex> lock(tableLock);
+            auto entry = table.find(sailingKey);
+            if (entry == table.end())
+            {
+                continue; // Removed since it was queued
+            }
+            // Cleared before the write so a change made during
+            // the write queues the sailing again
+            entry->second->dirty = false;
+        }
+
+        if (persist)
+        {
+            persist(sailingKey);
+        }
+    }
+}
+
+//*********************************************************
+// startFlusher()
+//*********************************************************
+void CapacityTable::startFlusher(Persist persist)
+{
+    stopFlusher();
+
+    this->persist = persist;
+    stopRequested = false;
+    flusher = thread(&CapacityTable::flusherLoop, this);
+}
+
+//*********************************************************
+// stopFlusher()
+//*********************************************************
+void CapacityTable::stopFlusher()
+{
+    if (flusher.joinable())
+    {
+        {
+            lock_guard<mutex> lock(dirtyLock);
+            stopRequested = true;
+        }
+        flushWanted.notify_all();
+        flusher.join();
+    }
+
+    flush();
+}
+
+//*********************************************************
+// flushNow()
+//*********************************************************
+void CapacityTable::flushNow()
+{
+    flush();
+}
+
+//*********************************************************
+// flusherLoop()
+//*********************************************************
+void CapacityTable::flusherLoop()
+{
+    unique_lock<mutex> lock(dirtyLock);
+    while (!stopRequested)
+    {
+        flushWanted.wait_for(lock,
+                    chrono::milliseconds(FLUSH_INTERVAL_MS));
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
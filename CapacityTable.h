@@ -0,0 +1,179 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// CapacityTable.h
+//*********************************************************
+// Purpose: In-memory table of the remaining high and low
+// lane lengths of every sailing. Lengths are whole
+// decimetres, as in sailing.dat, kept in atomics and changed
+// by compare-and-swap, so bookings on one sailing never wait
+// on a lock. Sailings are identified by their encoded
+// 32-bit key (Sailing::isValidSailingId).
+// Changed sailings are marked dirty and written back to
+// sailing.dat by a background flusher thread.
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, sync with other processes
+// Oct 17, 2026 Version 3 - Team 18, decimetres as on disk
+// Oct 17, 2026 Version 4 - Team 18, keyed by sailing key
+// Oct 17, 2026 Version 5 - Team 18, flushNow for checkpoints
+// Oct 17, 2026 Version 6 - Team 18, flushNow waits for the
+// flusher's batch
+//*********************************************************
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <cstdint>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+class CapacityTable
+{
+public:
+    // Longest time a change waits before it is written back
+    static constexpr int FLUSH_INTERVAL_MS = 200;
+
+    // Writes one sailing's current lanes back to disk
+    typedef function<void(uint32_t sailingKey)> Persist;
+
+    //*********************************************************
+    // clear
+    //*********************************************************
+    // Removes every sailing and any pending write-back.
+    //*********************************************************
+    void clear();
+
+    //*********************************************************
+    // set
+    //*********************************************************
+    // Adds a sailing or replaces its lanes, e.g. when loaded
+    // from disk. The sailing is not marked dirty.
+    // in: sailingKey - encoded sailing ID
+    //     high, low - remaining lanes in decimetres
+    //*********************************************************
+    void set(uint32_t sailingKey, int high, int low);
+
+    //*********************************************************
+    // remove
+    //*********************************************************
+    // Drops a sailing from the table.
+    //*********************************************************
+    void remove(uint32_t sailingKey);
+
+    //*********************************************************
+    // get
+    //*********************************************************
+    // in: sailingKey
+    // out: high, low - remaining lanes in decimetres; false if
+    // the sailing is not in the table
+    //*********************************************************
+    bool get(uint32_t sailingKey, int &high, int &low) const;
+
+    //*********************************************************
+    // tryTake
+    //*********************************************************
+    // Deducts amount from one lane if the lane still holds at
+    // least needed, as one atomic step.
+    // in: sailingKey, highLane - true for the high lane,
+    //     needed, amount - in decimetres
+    // out: high, low - lanes after the call; false if the
+    // sailing is unknown or the lane is too short
+    //*********************************************************
+    bool tryTake(uint32_t sailingKey, bool highLane,
+                 int needed, int amount, int &high, int &low);
+
+    //*********************************************************
+    // add
+    //*********************************************************
+    // Adds amount (which may be negative) to one lane.
+    // in: sailingKey, highLane, amount - in decimetres
+    // out: high, low - lanes after the call; false if the
+    // sailing is unknown
+    //*********************************************************
+    bool add(uint32_t sailingKey, bool highLane, int amount,
+             int &high, int &low);
+
+    //*********************************************************
+    // sync
+    //*********************************************************
+    // Merges the lanes stored on disk, which other processes
+    // may have changed, with the table. Whatever the disk
+    // gained or lost since the last sync is applied to the
+    // table, and the result is what should be written back.
+    // Callers hold the sailing's record lock.
+    // in-out: diskHigh, diskLow - lanes read from the record,
+    //     returned as the lanes to write
+    // out: false if the sailing is not in the table
+    //*********************************************************
+    bool sync(uint32_t sailingKey, int &diskHigh,
+              int &diskLow);
+
+    //*********************************************************
+    // startFlusher
+    //*********************************************************
+    // Starts the thread that writes dirty sailings back.
+    // in: persist - called once per dirty sailing; it must
+    //     read the current lanes with get()
+    //*********************************************************
+    void startFlusher(Persist persist);
+
+    //*********************************************************
+    // stopFlusher
+    //*********************************************************
+    // Stops the flusher and writes back whatever is still
+    // dirty. Must not be called while holding a lock that
+    // persist takes.
+    //*********************************************************
+    void stopFlusher();
+
+    //*********************************************************
+    // flushNow
+    //*********************************************************
+    // Writes back every dirty sailing from the calling thread,
+    // e.g. before a checkpoint syncs sailing.dat. A batch the
+    // flusher is writing meanwhile is finished first, so every
+    // change made before the call is on disk when it returns.
+    // Same locking rule as stopFlusher.
+    //*********************************************************
+    void flushNow();
+
+private:
+    // Remaining lanes of one sailing
+    struct Lanes
+    {
+        atomic<int> high;
+        atomic<int> low;
+        // Lanes on disk as of the last load or sync
+        atomic<int> baseHigh;
+        atomic<int> baseLow;
+        // Set while the sailing is queued for write-back
+        atomic<bool> dirty;
+    };
+
+    // Sailing key -> lanes. Entries are only added or removed
+    // under an exclusive lock; lane updates need a shared one.
+    unordered_map<uint32_t, unique_ptr<Lanes>> table;
+    mutable shared_mutex tableLock;
+
+    // Sailings waiting for write-back
+    vector<uint32_t> dirtyKeys;
+    mutex dirtyLock;
+    condition_variable flushWanted;
+    // Held while a batch is written back
+    mutex flushLock;
+
+    thread flusher;
+    bool stopRequested = false;
+    Persist persist;
+
+    void markDirty(uint32_t sailingKey, Lanes &lanes);
+    void flush();
+    void flusherLoop();
+};
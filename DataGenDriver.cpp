@@ -0,0 +1,429 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// DataGenDriver.cpp
+//*********************************************************
+// Purpose: Synthetic dataset generator. Writes vessel.dat,
+// sailing.dat, vehicle.dat and reservation.dat in the same
+// record layouts the entity classes use (each record is
+// laid out by the class's own writeToBuffer), so the files
+// can be opened by ferry as is.
+//
+// Records are collected in a large buffer and written in
+// blocks, so millions of records take seconds instead of
+// one flush per record.
+//
+// Distributions:
+// - sailings run on named routes (plus generated prefixes
+//   when more are needed), days 01-31, popular hours first
+// - a configurable share of vehicles are special (taller
+//   and longer than a regular vehicle)
+// - reservations pick sailings with a Zipf-like skew, so a
+//   few sailings are busy and most are quiet; lane space is
+//   deducted exactly as Sailing::tryReserveSpace does, and a
+//   booking that does not fit is retried on another sailing
+//
+// Usage: datagen [-d dir] [-v vessels] [-s sailings]
+//                [-c vehicles] [-r reservations]
+//                [-p specialShare] [-z skew] [-S seed]
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, lengths in decimetres
+//*********************************************************
+
+#include "Reservation.h"
+#include "Sailing.h"
+#include "Vehicle.h"
+#include "Vessel.h"
+#include "Util.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+// Bytes collected before each write
+static const size_t WRITE_BLOCK_SIZE = 1024 * 1024;
+// Attempts to place a reservation before it is dropped
+static const int PLACE_ATTEMPTS = 8;
+
+// Route prefixes used before generated ones
+static const char *ROUTES[] = {
+    "tsa", "swb", "hsb", "nan", "dep", "lan",
+    "ful", "ssp", "cro", "pow", "com", "pru"
+};
+static const int ROUTE_COUNT = sizeof(ROUTES) / sizeof(ROUTES[0]);
+
+// Departure hours, busiest first; the remaining hours are
+// only used once every route and day has these
+static const int HOURS[] = {
+    7, 9, 11, 13, 15, 17, 19, 21,
+    6, 8, 10, 12, 14, 16, 18, 20,
+    5, 22, 23, 0, 1, 2, 3, 4
+};
+static const int HOUR_COUNT = sizeof(HOURS) / sizeof(HOURS[0]);
+static const int DAY_COUNT = 31;
+
+// Vessel name stems
+static const char *VESSEL_NAMES[] = {
+    "Queen of ", "Spirit of ", "Coastal ", "Island "
+};
+
+//*********************************************************
+// Writes fixed-size records to a file in large blocks
+//*********************************************************
+template <typename T>
+class BulkWriter
+{
+public:
+    //*********************************************************
+    // Constructor
+    // in: fileName - file to create (truncated if present)
+    //*********************************************************
+    BulkWriter(const string &fileName)
+        : file(fileName, ios::out | ios::binary | ios::trunc),
+          used(0), written(0)
+    {
+        buffer.resize(WRITE_BLOCK_SIZE / T::RECORD_SIZE
+                        * T::RECORD_SIZE);
+        if (!file.is_open())
+        {
+            cerr << "Error creating " << fileName << "." << endl;
+        }
+    }
+
+    //*********************************************************
+    // add
+    // Appends one record to the buffer
+    //*********************************************************
+    void add(const T &record)
+    {
+        record.writeToBuffer(buffer.data() + used);
+        used += T::RECORD_SIZE;
+        written++;
+        if (used == buffer.size())
+        {
+            flush();
+        }
+    }
+
+    //*********************************************************
+    // close
+    // Writes what is left and closes the file
+    // out: number of records written
+    //*********************************************************
+    long close()
+    {
+        flush();
+        file.close();
+        return written;
+    }
+
+private:
+    ofstream file;
+    vector<char> buffer;
+    size_t used;
+    long written;
+
+    void flush()
+    {
+        file.write(buffer.data(), used);
+        used = 0;
+    }
+};
+
+//*********************************************************
+// Three-letter prefix for route r: the named routes first,
+// then every other letter combination. Linear in r, so
+// callers compute each prefix once.
+//*********************************************************
+static string routePrefix(int r)
+{
+    if (r < ROUTE_COUNT)
+    {
+        return ROUTES[r];
+    }
+
+    // Skip combinations that spell a named route
+    int combination = r - ROUTE_COUNT;
+    for (int c = 0; ; c++)
+    {
+        string prefix = {
+            static_cast<char>('a' + c / (26 * 26) % 26),
+            static_cast<char>('a' + c / 26 % 26),
+            static_cast<char>('a' + c % 26)
+        };
+        if (find(ROUTES, ROUTES + ROUTE_COUNT, prefix)
+                != ROUTES + ROUTE_COUNT)
+        {
+            continue;
+        }
+        if (combination-- == 0)
+        {
+            return prefix;
+        }
+    }
+}
+
+//*********************************************************
+// License plate for vehicle i: three letters and four
+// digits, unique for the first 175 million vehicles
+//*********************************************************
+static string licenseFor(long i)
+{
+    long letters = i / 10000;
+    char license[16];
+    snprintf(license, sizeof(license), "%c%c%c%04ld",
+             static_cast<char>('A' + letters / (26 * 26) % 26),
+             static_cast<char>('A' + letters / 26 % 26),
+             static_cast<char>('A' + letters % 26), i % 10000);
+    return license;
+}
+
+int main(int argc, char *argv[])
+{
+    string directory = ".";
+    long vesselCount = 50;
+    long sailingCount = 10000;
+    long vehicleCount = 100000;
+    long reservationCount = 500000;
+    double specialShare = 0.1;
+    double skew = 1.0;
+    unsigned int seed = 18;
+
+    // Options come in pairs
+    bool valid = argc % 2 == 1;
+    for (int i = 1; valid && i + 1 < argc; i += 2)
+    {
+        string option = argv[i];
+        const char *value = argv[i + 1];
+        if (option == "-d") directory = value;
+        else if (option == "-v") vesselCount = atol(value);
+        else if (option == "-s") sailingCount = atol(value);
+        else if (option == "-c") vehicleCount = atol(value);
+        else if (option == "-r") reservationCount = atol(value);
+        else if (option == "-p") specialShare = atof(value);
+        else if (option == "-z") skew = atof(value);
+        else if (option == "-S") seed = atol(value);
+        else valid = false;
+    }
+    if (!valid || vesselCount <= 0 || sailingCount < 0
+        || vehicleCount <= 0 || reservationCount < 0)
+    {
+        cerr << "Usage: datagen [-d dir] [-v vessels] "
+             << "[-s sailings] [-c vehicles] [-r reservations] "
+             << "[-p specialShare] [-z skew] [-S seed]" << endl;
+        return 1;
+    }
+
+    long maxSailings = 26L * 26 * 26 * DAY_COUNT * HOUR_COUNT;
+    if (sailingCount > maxSailings)
+    {
+        cerr << "At most " << maxSailings
+             << " unique sailing IDs exist." << endl;
+        return 1;
+    }
+
+    filesystem::create_directories(directory);
+    filesystem::current_path(directory);
+
+    // Any index left over from older data is now stale
+    filesystem::remove("sailing.idx");
+    filesystem::remove("vehicle.idx");
+
+    auto start = chrono::steady_clock::now();
+    mt19937 random(seed);
+
+    // Vessels
+    vector<int> vesselHCLL(vesselCount), vesselLCLL(vesselCount);
+    vector<string> vesselNames(vesselCount);
+    BulkWriter<Vessel> vessels("vessel.dat");
+    for (long i = 0; i < vesselCount; i++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%s%ld",
+                 VESSEL_NAMES[i % 4], i + 1);
+        vesselNames[i] = name;
+        // Low-ceiling lanes are roughly twice the high ones
+        vesselHCLL[i] = uniform_int_distribution<int>(
+                            100, 1200)(random);
+        vesselLCLL[i] = uniform_int_distribution<int>(
+                            vesselHCLL[i], 3600)(random);
+        vessels.add(Vessel(vesselNames[i], vesselHCLL[i],
+                           vesselLCLL[i]));
+    }
+
+    // Sailing IDs; busiest hours first, then every day, then
+    // every route, so small datasets look like a schedule
+    long routeCount = max<long>(ROUTE_COUNT,
+            (sailingCount + DAY_COUNT * HOUR_COUNT - 1)
+            / (DAY_COUNT * HOUR_COUNT));
+    vector<string> routes(routeCount);
+    for (long r = 0; r < routeCount; r++)
+    {
+        routes[r] = routePrefix(r);
+    }
+    vector<string> sailingIds;
+    sailingIds.reserve(sailingCount);
+    for (int h = 0; h < HOUR_COUNT; h++)
+    {
+        for (int day = 1; day <= DAY_COUNT; day++)
+        {
+            for (long r = 0; r < routeCount; r++)
+            {
+                if (static_cast<long>(sailingIds.size())
+                        == sailingCount)
+                {
+                    break;
+                }
+                char id[16];
+                snprintf(id, sizeof(id), "%s-%02d-%02d",
+                         routes[r].c_str(), day, HOURS[h]);
+                sailingIds.push_back(id);
+            }
+        }
+    }
+
+    // Remaining lane space per sailing in decimetres, filled
+    // in as reservations are placed
+    vector<long> sailingVessel(sailingCount);
+    vector<int> HRL(sailingCount), LRL(sailingCount);
+    uniform_int_distribution<long> anyVessel(0, vesselCount - 1);
+    for (long i = 0; i < sailingCount; i++)
+    {
+        sailingVessel[i] = anyVessel(random);
+        HRL[i] = vesselHCLL[sailingVessel[i]]
+                    * Util::DECIMETRES_PER_METRE;
+        LRL[i] = vesselLCLL[sailingVessel[i]]
+                    * Util::DECIMETRES_PER_METRE;
+    }
+
+    // Vehicles; special sizes are 2.1-4.5 m high and
+    // 7.1-25.0 m long, in decimetres
+    uniform_int_distribution<int> specialHeight(21, 45);
+    uniform_int_distribution<int> specialLength(71, 250);
+    vector<int> vehicleLength(vehicleCount);
+    vector<bool> vehicleSpecial(vehicleCount);
+    bernoulli_distribution isSpecial(specialShare);
+    uniform_int_distribution<int> phoneDigits(0, 9999999);
+    BulkWriter<Vehicle> vehicles("vehicle.dat");
+    for (long i = 0; i < vehicleCount; i++)
+    {
+        int height = REGULAR_VEHICLE_HEIGHT;
+        int length = REGULAR_VEHICLE_LENGTH;
+        if (isSpecial(random))
+        {
+            height = specialHeight(random);
+            length = specialLength(random);
+        }
+        vehicleLength[i] = length;
+        // Same test deleteReservation uses for the lane
+        vehicleSpecial[i] = height > REGULAR_VEHICLE_HEIGHT;
+
+        char phone[16];
+        snprintf(phone, sizeof(phone), "604%07d",
+                 phoneDigits(random));
+        vehicles.add(Vehicle(licenseFor(i), phone, height,
+                             length));
+    }
+
+    // Zipf-like popularity: the sailing of rank k is booked
+    // in proportion to 1 / k^skew, ranks shuffled so busy
+    // sailings are spread over the schedule
+    vector<double> popularity(sailingCount);
+    double total = 0;
+    for (long k = 0; k < sailingCount; k++)
+    {
+        total += 1.0 / pow(k + 1, skew);
+        popularity[k] = total;
+    }
+    vector<long> rankedSailing(sailingCount);
+    for (long i = 0; i < sailingCount; i++)
+    {
+        rankedSailing[i] = i;
+    }
+    shuffle(rankedSailing.begin(), rankedSailing.end(), random);
+    uniform_real_distribution<double> anyWeight(0, total);
+    uniform_int_distribution<long> anyVehicle(0, vehicleCount - 1);
+
+    // Reservations
+    unordered_set<long long> booked;
+    booked.reserve(reservationCount);
+    long dropped = 0;
+    BulkWriter<Reservation> reservations("reservation.dat");
+    for (long i = 0; i < reservationCount && sailingCount > 0;
+            i++)
+    {
+        bool placed = false;
+        for (int attempt = 0; attempt < PLACE_ATTEMPTS && !placed;
+                attempt++)
+        {
+            long rank = upper_bound(popularity.begin(),
+                                    popularity.end(),
+                                    anyWeight(random))
+                        - popularity.begin();
+            long sailing = rankedSailing[min(rank,
+                                             sailingCount - 1)];
+            long vehicle = anyVehicle(random);
+
+            // One reservation per vehicle per sailing
+            long long pair = static_cast<long long>(vehicle)
+                                * sailingCount + sailing;
+            if (booked.count(pair) > 0)
+            {
+                continue;
+            }
+
+            // Same rule as Sailing::tryReserveSpace()
+            int &lane = vehicleSpecial[vehicle] ? HRL[sailing]
+                                                : LRL[sailing];
+            if (lane < vehicleLength[vehicle])
+            {
+                continue;
+            }
+            lane -= vehicleLength[vehicle] + Sailing::VEHICLE_GAP;
+
+            booked.insert(pair);
+            reservations.add(Reservation(licenseFor(vehicle),
+                                         sailingIds[sailing],
+                                         false));
+            placed = true;
+        }
+
+        if (!placed)
+        {
+            dropped++;
+        }
+    }
+
+    // Sailings last, now that their remaining space is known
+    BulkWriter<Sailing> sailings("sailing.dat");
+    for (long i = 0; i < sailingCount; i++)
+    {
+        sailings.add(Sailing(sailingIds[i].c_str(),
+                             vesselNames[sailingVessel[i]]
+                                 .c_str(),
+                             HRL[i], LRL[i]));
+    }
+
+    long vesselsWritten = vessels.close();
+    long vehiclesWritten = vehicles.close();
+    long reservationsWritten = reservations.close();
+    long sailingsWritten = sailings.close();
+
+    double seconds = chrono::duration<double>(
+        chrono::steady_clock::now() - start).count();
+    cout << "vessels " << vesselsWritten << endl
+         << "sailings " << sailingsWritten << endl
+         << "vehicles " << vehiclesWritten << endl
+         << "reservations " << reservationsWritten
+         << " (" << dropped << " did not fit)" << endl
+         << "seconds " << seconds << endl;
+    return 0;
+}
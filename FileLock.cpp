@@ -0,0 +1,134 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// FileLock.cpp
+//*********************************************************
+// Purpose: Implements advisory byte-range locks with fcntl.
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, tryLock
+// Oct 17, 2026 Version 3 - Team 18, guard mutex
+//*********************************************************
+
+#include "FileLock.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Open file description locks where available
+#ifdef F_OFD_SETLKW
+static const int SET_LOCK_WAIT = F_OFD_SETLKW;
+static const int SET_LOCK = F_OFD_SETLK;
+#else
+static const int SET_LOCK_WAIT = F_SETLKW;
+static const int SET_LOCK = F_SETLK;
+#endif
+
+//*********************************************************
+// Builds the fcntl request for a range
+//*********************************************************
+static struct flock makeRange(short type, off_t start,
+                                off_t length)
+{
+    struct flock range;
+    memset(&range, 0, sizeof(range));
+    range.l_type = type;
+    range.l_whence = SEEK_SET;
+    range.l_start = start;
+    range.l_len = length;
+    // Must be 0 for open file description locks
+    range.l_pid = 0;
+    return range;
+}
+
+//*********************************************************
+// Constructor
+//*********************************************************
+FileLock::FileLock(const OwnedMutex *guard)
+{
+    fd = -1;
+    this->guard = guard;
+}
+
+//*********************************************************
+// open()
+//*********************************************************
+bool FileLock::open(const string &fileName)
+{
+    close();
+    fd = ::open(fileName.c_str(), O_RDWR);
+    return fd >= 0;
+}
+
+//*********************************************************
+// close()
+//*********************************************************
+void FileLock::close()
+{
+    if (fd >= 0)
+    {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+//*********************************************************
+// lock()
+//*********************************************************
+void FileLock::lock(off_t start, off_t length, bool exclusive)
+{
+    if (fd < 0)
+    {
+        return;
+    }
+
+    struct flock range = makeRange(exclusive ? F_WRLCK : F_RDLCK,
+                                    start, length);
+    // Retry if a signal interrupts the wait
+    while (fcntl(fd, SET_LOCK_WAIT, &range) < 0 && errno == EINTR)
+    {
+    }
+}
+
+//*********************************************************
+// tryLock()
+//*********************************************************
+bool FileLock::tryLock(off_t start, off_t length, bool exclusive)
+{
+    if (fd < 0)
+    {
+        return true;
+    }
+
+    struct flock range = makeRange(exclusive ? F_WRLCK : F_RDLCK,
+                                    start, length);
+    int result;
+    while ((result = fcntl(fd, SET_LOCK, &range)) < 0 
+            && errno == EINTR)
+    {
+    }
+    return result == 0;
+}
+
+//*********************************************************
+// unlock()
+//*********************************************************
+void FileLock::unlock(off_t start, off_t length)
+{
+    if (fd < 0)
+    {
+        return;
+    }
+
+    struct flock range = makeRange(F_UNLCK, start, length);
+    fcntl(fd, SET_LOCK, &range);
+}
+
+//*********************************************************
+// guardHeld()
+//*********************************************************
+bool FileLock::guardHeld() const
+{
+    return guard == nullptr || guard->heldByThisThread();
+}
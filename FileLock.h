@@ -0,0 +1,195 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// FileLock.h
+//*********************************************************
+// Purpose: Advisory byte-range locks on a data file, so
+// several ferry processes can share the .dat files. An
+// in-place record update locks just that record's bytes;
+// only paths that move records or shrink the file lock the
+// whole file.
+//
+// The locks are taken through a descriptor of their own,
+// opened at startup and kept open until shutdown. Where the
+// system has open file description locks (Linux) they are
+// used, since classic POSIX locks are dropped whenever any
+// descriptor of the file is closed by the process.
+//
+// Locks only exclude other processes. Every thread shares
+// the one descriptor, so its locks are the process's: a
+// range one thread unlocks is unlocked for all of them, and
+// overlapping ranges merge. Only one thread at a time may
+// therefore lock ranges of a file: the one holding the
+// file's guard, its lock in Util. guardHeld lets callers
+// check this.
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, tryLock
+// Oct 17, 2026 Version 3 - Team 18, guard mutex
+//*********************************************************
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <sys/types.h>
+
+using namespace std;
+
+//*********************************************************
+// OwnedMutex
+//*********************************************************
+// A recursive mutex that knows which thread holds it, so
+// code that relies on it being held can check. Used with
+// lock_guard and unique_lock like any other mutex.
+//*********************************************************
+class OwnedMutex
+{
+public:
+    void lock()
+    {
+        inner.lock();
+        if (depth++ == 0)
+        {
+            owner = this_thread::get_id();
+        }
+    }
+
+    bool try_lock()
+    {
+        if (!inner.try_lock())
+        {
+            return false;
+        }
+        if (depth++ == 0)
+        {
+            owner = this_thread::get_id();
+        }
+        return true;
+    }
+
+    void unlock()
+    {
+        if (--depth == 0)
+        {
+            owner = thread::id();
+        }
+        inner.unlock();
+    }
+
+    //*****************************************************
+    // heldByThisThread
+    //*****************************************************
+    // out: true if the calling thread holds the mutex
+    //*****************************************************
+    bool heldByThisThread() const
+    {
+        return owner == this_thread::get_id();
+    }
+
+private:
+    recursive_mutex inner;
+    // Only changed by the holder
+    int depth = 0;
+    atomic<thread::id> owner{thread::id()};
+};
+
+class FileLock
+{
+public:
+    //*********************************************************
+    // Constructor
+    //*********************************************************
+    // in: guard - mutex a thread must hold to lock ranges, or
+    //     nullptr if the caller keeps threads apart itself
+    //*********************************************************
+    explicit FileLock(const OwnedMutex *guard = nullptr);
+
+    //*********************************************************
+    // open
+    //*********************************************************
+    // Opens the lock descriptor for a data file.
+    // in: fileName - the data file, which must exist
+    // out: true if locking is available
+    //*********************************************************
+    bool open(const string &fileName);
+
+    //*********************************************************
+    // close
+    //*********************************************************
+    // Closes the lock descriptor, releasing its locks.
+    //*********************************************************
+    void close();
+
+    //*********************************************************
+    // lock
+    //*********************************************************
+    // Waits for and takes a lock on a byte range. Does
+    // nothing if the descriptor is not open. Ranges taken by
+    // one caller must not overlap, since overlapping locks of
+    // one owner merge.
+    // in: start - first byte
+    //     length - number of bytes, 0 for "to the end of the
+    //     file and beyond"
+    //     exclusive - true for a write lock, false for read
+    //*********************************************************
+    void lock(off_t start, off_t length, bool exclusive);
+
+    //*********************************************************
+    // tryLock
+    //*********************************************************
+    // Same as lock, but returns at once if another process
+    // holds a conflicting lock.
+    // out: true if the lock was taken (or the descriptor is
+    // not open)
+    //*********************************************************
+    bool tryLock(off_t start, off_t length, bool exclusive);
+
+    //*********************************************************
+    // unlock
+    //*********************************************************
+    // Releases a range taken by lock().
+    //*********************************************************
+    void unlock(off_t start, off_t length);
+
+    //*********************************************************
+    // guardHeld
+    //*********************************************************
+    // out: true if the calling thread holds the guard, or
+    // there is none
+    //*********************************************************
+    bool guardHeld() const;
+
+private:
+    int fd;
+    const OwnedMutex *guard;
+};
+
+//*********************************************************
+// RangeLock
+//*********************************************************
+// Holds a FileLock range for the lifetime of the object.
+//*********************************************************
+class RangeLock
+{
+public:
+    RangeLock(FileLock &fileLock, off_t start, off_t length,
+              bool exclusive)
+        : fileLock(fileLock), start(start), length(length)
+    {
+        fileLock.lock(start, length, exclusive);
+    }
+
+    ~RangeLock()
+    {
+        fileLock.unlock(start, length);
+    }
+
+    RangeLock(const RangeLock &) = delete;
+    RangeLock &operator=(const RangeLock &) = delete;
+
+private:
+    FileLock &fileLock;
+    off_t start;
+    off_t length;
+};
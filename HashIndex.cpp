@@ -0,0 +1,502 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// HashIndex.cpp
+//*********************************************************
+// Purpose: Implements the persistent on-disk hash index.
+// The file holds a small header followed by a power-of-two
+// table of fixed-size buckets (state, key, slot). Deleted
+// entries leave a marker so probe chains stay intact, and
+// the table is rebuilt at twice the size once it is half
+// full.
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, data file fingerprint
+// Oct 17, 2026 Version 3 - Team 18, locked against other
+// processes
+//*********************************************************
+
+#include "HashIndex.h"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+// Identifies a valid index file
+static const char INDEX_MAGIC[4] = {'F', 'I', 'D', '2'};
+
+//*********************************************************
+// Constructor
+// in: fileName, keyLength
+//*********************************************************
+HashIndex::HashIndex(const string &fileName, int keyLength)
+{
+    this->fileName = fileName;
+    this->keyLength = keyLength;
+    // state byte + key bytes + slot number
+    bucketSize = 1 + keyLength + sizeof(int);
+    capacity = 0;
+    count = 0;
+    deleted = 0;
+    keySum = 0;
+    dataSize = 0;
+}
+
+//*********************************************************
+// open()
+// Opens the index file and validates its header against
+// the data file it indexes.
+//*********************************************************
+bool HashIndex::open(int expectedCount,
+                        long long expectedDataSize,
+                        unsigned int expectedKeySum)
+{
+    if (file.is_open())
+    {
+        file.close();
+    }
+
+    file.open(fileName, ios::in | ios::out | ios::binary);
+    if (!file.is_open())
+    {
+        // No index yet, create an empty file
+        file.clear();
+        file.open(fileName, ios::out | ios::binary);
+        file.close();
+        file.open(fileName, ios::in | ios::out | ios::binary);
+        fileLock.open(fileName);
+        return false;
+    }
+
+    fileLock.open(fileName);
+    RangeLock lock(fileLock, 0, 0, false);
+    if (!readHeader() || count != expectedCount
+        || keySum != expectedKeySum
+        || dataSize != expectedDataSize)
+    {
+        return false;
+    }
+
+    // The table must be complete
+    file.seekg(0, ios::end);
+    if (file.tellg() != bucketOffset(capacity))
+    {
+        file.clear();
+        return false;
+    }
+
+    return true;
+}
+
+//*********************************************************
+// close()
+//*********************************************************
+void HashIndex::close()
+{
+    if (file.is_open())
+    {
+        file.close();
+    }
+    fileLock.close();
+}
+
+//*********************************************************
+// clear()
+//*********************************************************
+void HashIndex::clear(int expectedCount)
+{
+    RangeLock lock(fileLock, 0, 0, true);
+    resize(expectedCount);
+}
+
+//*********************************************************
+// resize()
+// Rewrites the file as an empty table large enough for
+// expectedCount entries at no more than half load.
+//*********************************************************
+void HashIndex::resize(int expectedCount)
+{
+    int newCapacity = INITIAL_CAPACITY;
+    while (newCapacity < expectedCount * 2 + 1)
+    {
+        newCapacity *= 2;
+    }
+
+    count = 0;
+    keySum = 0;
+    rehash(newCapacity);
+}
+
+//*********************************************************
+// size()
+//*********************************************************
+int HashIndex::size() const
+{
+    return count;
+}
+
+//*********************************************************
+// setDataSize()
+//*********************************************************
+void HashIndex::setDataSize(long long dataSize)
+{
+    RangeLock lock(fileLock, 0, 0, true);
+    if (!readHeader() || this->dataSize != dataSize)
+    {
+        this->dataSize = dataSize;
+        writeHeader();
+    }
+}
+
+//*********************************************************
+// entryChecksum()
+// FNV-1a over the key bytes, then the slot's bytes
+//*********************************************************
+unsigned int HashIndex::entryChecksum(const char *key,
+                                        int slot) const
+{
+    unsigned int h = hash(key);
+    const unsigned char *slotBytes =
+                reinterpret_cast<const unsigned char *>(&slot);
+    for (size_t i = 0; i < sizeof(int); i++)
+    {
+        h ^= slotBytes[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+//*********************************************************
+// find()
+// Returns the slot for key, or -1 if not indexed
+//*********************************************************
+int HashIndex::find(const char *key)
+{
+    RangeLock lock(fileLock, 0, 0, false);
+    if (!readHeader())
+    {
+        return -1;
+    }
+
+    int freeBucket;
+    int bucket = probe(key, freeBucket);
+
+    if (bucket < 0)
+    {
+        return -1;
+    }
+
+    vector<char> buffer(bucketSize);
+    readBucket(bucket, buffer.data());
+
+    int slot;
+    memcpy(&slot, buffer.data() + 1 + keyLength, sizeof(int));
+    return slot;
+}
+
+//*********************************************************
+// insert()
+// Adds key -> slot, replacing the slot if key exists
+//*********************************************************
+void HashIndex::insert(const char *key, int slot)
+{
+    RangeLock lock(fileLock, 0, 0, true);
+    if (!readHeader())
+    {
+        resize(0);
+    }
+
+    int freeBucket;
+    int bucket = probe(key, freeBucket);
+    vector<char> buffer(bucketSize);
+
+    if (bucket >= 0)
+    {
+        // The key moves: its old entry leaves the checksum
+        int oldSlot;
+        readBucket(bucket, buffer.data());
+        memcpy(&oldSlot, buffer.data() + 1 + keyLength,
+                sizeof(int));
+        keySum -= entryChecksum(key, oldSlot);
+    }
+    else
+    {
+        // Reusing a deleted bucket shortens later probes
+        readBucket(freeBucket, buffer.data());
+        if (buffer[0] == DELETED)
+        {
+            deleted--;
+        }
+        bucket = freeBucket;
+        count++;
+    }
+
+    buffer[0] = USED;
+    memcpy(buffer.data() + 1, key, keyLength);
+    memcpy(buffer.data() + 1 + keyLength, &slot, sizeof(int));
+    writeBucket(bucket, buffer.data());
+    keySum += entryChecksum(key, slot);
+
+    if ((count + deleted) * 2 > capacity)
+    {
+        // Grow based on live entries so deleted markers
+        // are dropped as well
+        int newCapacity = INITIAL_CAPACITY;
+        while (newCapacity < count * 4)
+        {
+            newCapacity *= 2;
+        }
+        rehash(newCapacity);
+    }
+    else
+    {
+        writeHeader();
+    }
+}
+
+//*********************************************************
+// erase()
+// Marks the bucket holding key as deleted
+//*********************************************************
+bool HashIndex::erase(const char *key)
+{
+    RangeLock lock(fileLock, 0, 0, true);
+    if (!readHeader())
+    {
+        return false;
+    }
+
+    int freeBucket;
+    int bucket = probe(key, freeBucket);
+
+    if (bucket < 0)
+    {
+        return false;
+    }
+
+    vector<char> buffer(bucketSize, 0);
+    int slot;
+    readBucket(bucket, buffer.data());
+    memcpy(&slot, buffer.data() + 1 + keyLength, sizeof(int));
+    keySum -= entryChecksum(key, slot);
+
+    memset(buffer.data(), 0, bucketSize);
+    buffer[0] = DELETED;
+    writeBucket(bucket, buffer.data());
+
+    count--;
+    deleted++;
+    writeHeader();
+    return true;
+}
+
+//*********************************************************
+// hash()
+// FNV-1a hash over the key bytes
+//*********************************************************
+unsigned int HashIndex::hash(const char *key) const
+{
+    unsigned int h = 2166136261u;
+    for (int i = 0; i < keyLength; i++)
+    {
+        h ^= static_cast<unsigned char>(key[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+//*********************************************************
+// bucketOffset()
+// Byte offset of a bucket within the index file
+//*********************************************************
+streamoff HashIndex::bucketOffset(int bucket) const
+{
+    return HEADER_SIZE
+            + static_cast<streamoff>(bucket) * bucketSize;
+}
+
+//*********************************************************
+// readBucket()
+//*********************************************************
+void HashIndex::readBucket(int bucket, char *buffer)
+{
+    file.clear();
+    file.seekg(bucketOffset(bucket), ios::beg);
+    file.read(buffer, bucketSize);
+}
+
+//*********************************************************
+// writeBucket()
+//*********************************************************
+void HashIndex::writeBucket(int bucket, const char *buffer)
+{
+    file.clear();
+    file.seekp(bucketOffset(bucket), ios::beg);
+    file.write(buffer, bucketSize);
+}
+
+//*********************************************************
+// readHeader()
+// Reloads the header another process may have changed.
+// out: false if the file holds no valid table
+//*********************************************************
+bool HashIndex::readHeader()
+{
+    char magic[4];
+    int storedKeyLength = 0;
+
+    file.clear();
+    file.seekg(0, ios::beg);
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char *>(&storedKeyLength),
+                sizeof(int));
+    file.read(reinterpret_cast<char *>(&capacity),
+                sizeof(int));
+    file.read(reinterpret_cast<char *>(&count), sizeof(int));
+    file.read(reinterpret_cast<char *>(&deleted),
+                sizeof(int));
+    file.read(reinterpret_cast<char *>(&keySum), sizeof(int));
+    file.read(reinterpret_cast<char *>(&dataSize),
+                sizeof(long long));
+
+    if (!file || memcmp(magic, INDEX_MAGIC, 4) != 0
+        || storedKeyLength != keyLength || capacity <= 0)
+    {
+        file.clear();
+        capacity = 0;
+        count = 0;
+        deleted = 0;
+        keySum = 0;
+        return false;
+    }
+    return true;
+}
+
+//*********************************************************
+// writeHeader()
+//*********************************************************
+void HashIndex::writeHeader()
+{
+    file.clear();
+    file.seekp(0, ios::beg);
+    file.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    file.write(reinterpret_cast<const char *>(&keyLength),
+                sizeof(int));
+    file.write(reinterpret_cast<const char *>(&capacity),
+                sizeof(int));
+    file.write(reinterpret_cast<const char *>(&count),
+                sizeof(int));
+    file.write(reinterpret_cast<const char *>(&deleted),
+                sizeof(int));
+    file.write(reinterpret_cast<const char *>(&keySum),
+                sizeof(int));
+    file.write(reinterpret_cast<const char *>(&dataSize),
+                sizeof(long long));
+    file.flush();
+}
+
+//*********************************************************
+// rehash()
+// Moves every live entry into a fresh table of the given
+// capacity. The whole table is built in memory and written
+// with a single call.
+//*********************************************************
+void HashIndex::rehash(int newCapacity)
+{
+    vector<char> oldTable;
+    if (count > 0 && capacity > 0)
+    {
+        oldTable.resize(static_cast<size_t>(capacity)
+                        * bucketSize);
+        file.clear();
+        file.seekg(HEADER_SIZE, ios::beg);
+        file.read(oldTable.data(), oldTable.size());
+    }
+
+    vector<char> newTable(static_cast<size_t>(newCapacity)
+                            * bucketSize, 0);
+    int oldCapacity = capacity;
+    capacity = newCapacity;
+    count = 0;
+    deleted = 0;
+
+    for (int i = 0; i < oldCapacity && !oldTable.empty(); i++)
+    {
+        const char *entry = oldTable.data()
+                            + static_cast<size_t>(i) * bucketSize;
+        if (entry[0] != USED)
+        {
+            continue;
+        }
+
+        unsigned int bucket = hash(entry + 1) & (capacity - 1);
+        while (newTable[static_cast<size_t>(bucket)
+                        * bucketSize] == USED)
+        {
+            bucket = (bucket + 1) & (capacity - 1);
+        }
+        memcpy(newTable.data()
+                + static_cast<size_t>(bucket) * bucketSize,
+                entry, bucketSize);
+        count++;
+    }
+
+    // Rewrite the file from scratch at its new size
+    file.close();
+    file.open(fileName, ios::out | ios::binary | ios::trunc);
+    file.close();
+    file.open(fileName, ios::in | ios::out | ios::binary);
+    if (!file.is_open())
+    {
+        cout << "Error opening index file " << fileName
+            << "." << endl;
+        return;
+    }
+
+    writeHeader();
+    file.seekp(HEADER_SIZE, ios::beg);
+    file.write(newTable.data(), newTable.size());
+    file.flush();
+}
+
+//*********************************************************
+// probe()
+// Walks the probe chain for key.
+// out: bucket holding key, or -1 if absent; freeBucket is
+// set to where key would be inserted
+//*********************************************************
+int HashIndex::probe(const char *key, int &freeBucket)
+{
+    freeBucket = -1;
+
+    vector<char> buffer(bucketSize);
+    unsigned int bucket = hash(key) & (capacity - 1);
+
+    for (int i = 0; i < capacity; i++)
+    {
+        readBucket(bucket, buffer.data());
+
+        if (buffer[0] == EMPTY)
+        {
+            if (freeBucket < 0)
+            {
+                freeBucket = bucket;
+            }
+            return -1;
+        }
+        else if (buffer[0] == DELETED)
+        {
+            if (freeBucket < 0)
+            {
+                freeBucket = bucket;
+            }
+        }
+        else if (memcmp(buffer.data() + 1, key, keyLength) == 0)
+        {
+            return bucket;
+        }
+
+        bucket = (bucket + 1) & (capacity - 1);
+    }
+
+    return -1;
+}
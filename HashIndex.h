@@ -0,0 +1,163 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// HashIndex.h
+//*********************************************************
+// Purpose: Persistent on-disk hash index mapping a fixed-
+// length key to the slot (record number) of a record in a
+// .dat file. Uses open addressing with linear probing so a
+// lookup touches one or two buckets regardless of how many
+// records the data file holds.
+//
+// The header keeps a fingerprint of the data file as the
+// index last saw it: its size and a checksum of every
+// (key, slot) entry. open compares both with the data file,
+// so an index left behind by a crash or by a file changed
+// without it is rebuilt instead of trusted.
+//
+// Several ferry processes share the index file. Each
+// method locks the whole file through a FileLock, shared
+// for find and exclusive for changes, and re-reads the
+// header under the lock, so a change or rehash made by
+// another process is seen and never interleaved with one.
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, data file fingerprint
+// Oct 17, 2026 Version 3 - Team 18, locked against other
+// processes
+//*********************************************************
+
+#pragma once
+
+#include "FileLock.h"
+#include <fstream>
+#include <string>
+
+using namespace std;
+
+class HashIndex
+{
+public:
+    // Longest key an index can hold (in bytes)
+    static const int MAX_KEY_LENGTH = 16;
+    // Number of buckets a new index starts with
+    static const int INITIAL_CAPACITY = 64;
+
+    //*********************************************************
+    // Constructor
+    //*********************************************************
+    // in: fileName - name of the index file on disk
+    //     keyLength - number of key bytes stored per entry
+    //*********************************************************
+    HashIndex(const string &fileName, int keyLength);
+
+    //*********************************************************
+    // open
+    //*********************************************************
+    // Opens the index file, creating an empty one if missing.
+    // in: expectedCount - number of live records in the data
+    //     file
+    //     dataSize - size of the data file in bytes
+    //     keySum - sum of entryChecksum over its live records
+    // out: true if the index is usable as is, false if it was
+    // missing or out of step and must be rebuilt by the caller
+    //*********************************************************
+    bool open(int expectedCount, long long dataSize,
+                unsigned int keySum);
+
+    //*********************************************************
+    // close
+    //*********************************************************
+    // Closes the index file and releases its lock.
+    //*********************************************************
+    void close();
+
+    //*********************************************************
+    // clear
+    //*********************************************************
+    // Discards every entry, sized for the given record count.
+    // in: expectedCount - number of entries about to be added
+    //*********************************************************
+    void clear(int expectedCount);
+
+    //*********************************************************
+    // find
+    //*********************************************************
+    // Looks up the slot stored for a key.
+    // in: key - keyLength bytes
+    // out: slot number, or -1 if the key is not indexed
+    //*********************************************************
+    int find(const char *key);
+
+    //*********************************************************
+    // insert
+    //*********************************************************
+    // Adds a key, or moves it to a new slot if already there.
+    // in: key - keyLength bytes, slot - record number
+    //*********************************************************
+    void insert(const char *key, int slot);
+
+    //*********************************************************
+    // erase
+    //*********************************************************
+    // Removes a key from the index.
+    // in: key - keyLength bytes
+    // out: true if the key was present
+    //*********************************************************
+    bool erase(const char *key);
+
+    //*********************************************************
+    // size
+    //*********************************************************
+    // out: number of keys currently indexed
+    //*********************************************************
+    int size() const;
+
+    //*********************************************************
+    // setDataSize
+    //*********************************************************
+    // Records the size of the data file after the caller has
+    // changed it.
+    // in: dataSize - in bytes
+    //*********************************************************
+    void setDataSize(long long dataSize);
+
+    //*********************************************************
+    // entryChecksum
+    //*********************************************************
+    // Checksum of one entry; the header keeps their sum.
+    // in: key - keyLength bytes, slot - record number
+    //*********************************************************
+    unsigned int entryChecksum(const char *key, int slot) const;
+
+private:
+    // Bucket states
+    static const char EMPTY = 0;
+    static const char USED = 1;
+    static const char DELETED = 2;
+
+    // Header: magic, key length, capacity, count, deleted,
+    // key checksum, data file size
+    static const int HEADER_SIZE = 4 + sizeof(int) * 5
+                                    + sizeof(long long);
+
+    string fileName;
+    int keyLength;
+    int bucketSize;
+    int capacity;
+    int count;
+    int deleted;
+    unsigned int keySum;
+    long long dataSize;
+    fstream file;
+    // Excludes other processes; callers keep threads apart
+    FileLock fileLock;
+
+    unsigned int hash(const char *key) const;
+    streamoff bucketOffset(int bucket) const;
+    void readBucket(int bucket, char *buffer);
+    void writeBucket(int bucket, const char *buffer);
+    bool readHeader();
+    void writeHeader();
+    void resize(int expectedCount);
+    void rehash(int newCapacity);
+    int probe(const char *key, int &freeBucket);
+};
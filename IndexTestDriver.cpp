@@ -0,0 +1,330 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// IndexTestDriver.cpp
+//*********************************************************
+// Purpose: Test driver for the persistent HashIndex kept by
+// RecordFile. Works on scratch vehicle and sailing files of
+// its own, never on the ferry's .dat files:
+// - rebuild: a missing index is rebuilt from the data file,
+//   and a clean one is reused on the next open
+// - stale index: a data file changed behind the index fails
+//   its fingerprint even with the same record count, and an
+//   entry pointing at another record is found anyway
+// - tombstone reuse: a sailing deleted in place and created
+//   again is found at its new slot, before and after compact
+// Prints PASS or FAIL per check; exits with the number of
+// failures.
+//
+// Usage: indextest [-d dir]
+//   -d dir  scratch directory (default indextest_data)
+// Oct 17, 2026 Version 1 - Team 18
+//*********************************************************
+
+#include "FileLock.h"
+#include "HashIndex.h"
+#include "RecordFile.h"
+#include "Sailing.h"
+#include "Vehicle.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+using namespace std;
+
+// Vehicles written by each test
+static const int TEST_VEHICLES = 200;
+// Times a sailing is deleted and created again
+static const int REUSE_ROUNDS = 100;
+
+static const string VEHICLE_FILE = "vehicle_test.dat";
+static const string VEHICLE_INDEX = "vehicle_test.idx";
+static const string SAILING_FILE = "sailing_test.dat";
+static const string SAILING_INDEX = "sailing_test.idx";
+
+static int failures = 0;
+
+//*********************************************************
+// Reports one check
+//*********************************************************
+static void check(bool passed, const string &name)
+{
+    cout << (passed ? "PASS " : "FAIL ") << name << endl;
+    if (!passed)
+    {
+        failures++;
+    }
+}
+
+//*********************************************************
+// Opens a fresh, empty data file and drops its index
+//*********************************************************
+static void openEmpty(fstream &file, const string &fileName,
+                        const string &indexName)
+{
+    if (file.is_open())
+    {
+        file.close();
+    }
+    remove(indexName.c_str());
+    ofstream(fileName, ios::binary | ios::trunc).close();
+    file.open(fileName, ios::in | ios::out | ios::binary);
+}
+
+//*********************************************************
+// The i-th test license plate
+//*********************************************************
+static string licenseFor(int i)
+{
+    char license[16];
+    snprintf(license, sizeof(license), "IDX%05d", i);
+    return license;
+}
+
+//*********************************************************
+// Key bytes of a license plate, as VehicleKey extracts them
+//*********************************************************
+static void vehicleKey(const string &license, char *key)
+{
+    Vehicle vehicle(license, "6045551234", 21, 71);
+    char record[Vehicle::RECORD_SIZE];
+    vehicle.writeToBuffer(record);
+    VehicleKey::extract(record, key);
+}
+
+//*********************************************************
+// Writes a vehicle record straight into a slot, leaving the
+// index as it was
+//*********************************************************
+static void writeBehindIndex(fstream &file, int slot,
+                                const string &license)
+{
+    Vehicle vehicle(license, "6045551234", 21, 71);
+    char record[Vehicle::RECORD_SIZE];
+    vehicle.writeToBuffer(record);
+    file.clear();
+    file.seekp(static_cast<streamoff>(slot) * Vehicle::RECORD_SIZE,
+                ios::beg);
+    file.write(record, Vehicle::RECORD_SIZE);
+    file.flush();
+}
+
+//*********************************************************
+// Whether the index file on disk matches the data file:
+// closes the index and opens it against a fresh count of
+// the data file, as RecordFile::openIndex does
+//*********************************************************
+template <typename T, typename KeyExtractor>
+static bool indexMatches(RecordFile<T, KeyExtractor> &records,
+                            HashIndex &index)
+{
+    records.closeIndex();
+
+    int liveCount = 0;
+    unsigned int keySum = 0;
+    char key[KeyExtractor::LENGTH];
+    records.scan([&](const char *record, int slot)
+    {
+        KeyExtractor::extract(record, key);
+        keySum += index.entryChecksum(key, slot);
+        liveCount++;
+        return true;
+    });
+
+    long long dataSize = static_cast<long long>(records.count())
+                            * T::RECORD_SIZE;
+    return index.open(liveCount, dataSize, keySum);
+}
+
+//*********************************************************
+// Whether every test vehicle is found at its own slot
+//*********************************************************
+static bool allFound(RecordFile<Vehicle, VehicleKey> &records)
+{
+    char key[VehicleKey::LENGTH];
+    Vehicle vehicle;
+    for (int i = 0; i < TEST_VEHICLES; i++)
+    {
+        vehicleKey(licenseFor(i), key);
+        if (records.find(key, vehicle) != i
+            || licenseFor(i) != vehicle.license)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//*********************************************************
+// rebuild
+//*********************************************************
+static void testRebuild()
+{
+    fstream file;
+    FileLock fileLock;
+    HashIndex index(VEHICLE_INDEX, VehicleKey::LENGTH);
+    RecordFile<Vehicle, VehicleKey> records(file, fileLock,
+                                    VEHICLE_FILE, &index);
+    openEmpty(file, VEHICLE_FILE, VEHICLE_INDEX);
+    records.openIndex();
+
+    for (int i = 0; i < TEST_VEHICLES; i++)
+    {
+        records.append(Vehicle(licenseFor(i), "6045551234",
+                                21, 71));
+    }
+    check(allFound(records), "rebuild: appended vehicles found");
+    check(indexMatches(records, index),
+            "rebuild: index kept in step while appending");
+
+    records.closeIndex();
+    remove(VEHICLE_INDEX.c_str());
+    check(!indexMatches(records, index),
+            "rebuild: missing index reported");
+    records.openIndex();
+    check(index.size() == TEST_VEHICLES && allFound(records),
+            "rebuild: missing index rebuilt");
+    check(indexMatches(records, index),
+            "rebuild: rebuilt index reused on the next open");
+
+    records.closeIndex();
+    file.close();
+}
+
+//*********************************************************
+// stale index
+//*********************************************************
+static void testStaleIndex()
+{
+    fstream file;
+    FileLock fileLock;
+    HashIndex index(VEHICLE_INDEX, VehicleKey::LENGTH);
+    RecordFile<Vehicle, VehicleKey> records(file, fileLock,
+                                    VEHICLE_FILE, &index);
+    openEmpty(file, VEHICLE_FILE, VEHICLE_INDEX);
+    records.openIndex();
+    for (int i = 0; i < TEST_VEHICLES; i++)
+    {
+        records.append(Vehicle(licenseFor(i), "6045551234",
+                                21, 71));
+    }
+
+    // Same record count and file size, one key replaced
+    records.closeIndex();
+    writeBehindIndex(file, 5, "CHANGED");
+    check(!indexMatches(records, index),
+            "stale index: changed key fails the fingerprint");
+
+    records.openIndex();
+    char key[VehicleKey::LENGTH];
+    Vehicle vehicle;
+    vehicleKey("CHANGED", key);
+    bool changedFound = records.find(key, vehicle) == 5;
+    vehicleKey(licenseFor(5), key);
+    check(changedFound && records.find(key, vehicle) == -1,
+            "stale index: reopened index has the new key only");
+
+    // Swap two records while the index is open, so its
+    // entries point at each other's records
+    writeBehindIndex(file, 0, licenseFor(1));
+    writeBehindIndex(file, 1, licenseFor(0));
+    vehicleKey(licenseFor(0), key);
+    int slot = records.find(key, vehicle);
+    check(slot == 1 && licenseFor(0) == vehicle.license,
+            "stale index: mismatched entry found by re-indexing");
+    check(indexMatches(records, index),
+            "stale index: re-indexed index matches the file");
+
+    records.closeIndex();
+    file.close();
+}
+
+//*********************************************************
+// tombstone reuse
+//*********************************************************
+static void testTombstoneReuse()
+{
+    fstream file;
+    FileLock fileLock;
+    HashIndex index(SAILING_INDEX, SailingKey::LENGTH);
+    RecordFile<Sailing, SailingKey> records(file, fileLock,
+                                    SAILING_FILE, &index);
+    openEmpty(file, SAILING_FILE, SAILING_INDEX);
+    records.openIndex();
+
+    const char *ids[] = {"abc-01-10", "abc-02-10", "abc-03-10"};
+    for (const char *id : ids)
+    {
+        records.append(Sailing(id, "Queen", 500, 500));
+    }
+
+    uint32_t key = 0;
+    Sailing::isValidSailingId(ids[1], key);
+    const char *keyBytes = reinterpret_cast<const char *>(&key);
+    Sailing sailing;
+    bool reused = true;
+    for (int round = 0; round < REUSE_ROUNDS && reused; round++)
+    {
+        int slot = records.find(keyBytes, sailing);
+        reused = records.eraseInPlace(slot)
+            && records.find(keyBytes, sailing) == -1;
+        int newSlot = records.append(Sailing(ids[1], "Queen",
+                                            500, 500));
+        reused = reused
+            && records.find(keyBytes, sailing) == newSlot;
+    }
+    check(reused && index.size() == 3,
+            "tombstone reuse: recreated sailing at its new slot");
+    check(records.deadCount() == REUSE_ROUNDS,
+            "tombstone reuse: every delete left a tombstone");
+    check(indexMatches(records, index),
+            "tombstone reuse: index matches with tombstones");
+
+    records.openIndex();
+    int removed = records.compact([](const char *, int)
+    {
+        return true;
+    });
+    bool allThere = removed == REUSE_ROUNDS;
+    for (const char *id : ids)
+    {
+        Sailing::isValidSailingId(id, key);
+        allThere = allThere && records.find(keyBytes, sailing) >= 0
+                    && string(id) == sailing.sailingId;
+    }
+    check(allThere && records.count() == 3,
+            "tombstone reuse: compact keeps every sailing");
+    check(indexMatches(records, index),
+            "tombstone reuse: index matches after compact");
+
+    records.closeIndex();
+    file.close();
+}
+
+int main(int argc, char *argv[])
+{
+    string directory = "indextest_data";
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "-d" && i + 1 < argc)
+        {
+            directory = argv[++i];
+        }
+        else
+        {
+            cerr << "Usage: indextest [-d dir]" << endl;
+            return 1;
+        }
+    }
+
+    filesystem::create_directories(directory);
+    filesystem::current_path(directory);
+
+    testRebuild();
+    testStaleIndex();
+    testTombstoneReuse();
+
+    cout << failures << " failed" << endl;
+    return failures;
+}
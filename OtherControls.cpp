@@ -6,6 +6,18 @@
 // vessels, and check-in functionality for FerryReserver 
 // system.
 // July 12, 2025 Version 2 - Darpandeep Kaur and Samanpreet
+// Oct 17, 2026 Version 3 - Team 18, createReservation
+// without prompts for the reservation server
+// Oct 17, 2026 Version 4 - Team 18, changes are committed
+// through the write-ahead log
+// Oct 17, 2026 Version 5 - Team 18, one lane rule for new
+// and known vehicles
+// Oct 17, 2026 Version 6 - Team 18, publish to the versioned
+// sailing table
+// Oct 17, 2026 Version 7 - Team 18, occupancy changes sent to
+// SailingVersions as deltas; check-in by license and sailing
+// Oct 17, 2026 Version 8 - Team 18, each change is logged
+// before it is made
 //*********************************************************
 
 #include "OtherControls.h"
@@ -14,8 +26,12 @@
 #include "Vessel.h"
 #include "Reservation.h"
 #include "Util.h"
+#include "WriteAheadLog.h"
+#include "SailingVersions.h"
 #include <string>
 #include <iostream>
+#include <limits>
+#include <mutex>
 
 using namespace std;
 
@@ -37,22 +53,18 @@ OtherControls::OtherControls() // Default Constructor
 //*********************************************************
 // createReservation()
 //*********************************************************
-// Implements reservation logic including:
+// Interactive reservation entry point:
 // - sailing lookup
 // - duplicate reservation check
-// - vehicle existence and info collection
-// - vehicle writing (if new)
-// - sailing capacity check
-// - reservation creation
-// Also adjusts space based on vehicle size.
+// - for an unknown vehicle, format checks and a prompt for
+//   its dimensions
+// The booking itself is made by the overload below.
 // in: sailingId, licensePlate
 //*********************************************************
 bool OtherControls::createReservation(string &phoneNumber, 
                     string &sailingId, string &licensePlate) 
 {
     // Step 1: check if sailing exists
-    // Created a sailing instance; pass it by reference so it 
-    // can be filled with file data if found
     // Check if the sailing with the given ID exists
     if (!Sailing::checkExist(sailingId)) 
     {
@@ -72,125 +84,210 @@ bool OtherControls::createReservation(string &phoneNumber,
         return false; 
     }
 
-    // Step 4: check if vehicle exists
-    // Check if vehicle is known from license plate
-    // Variables to store vehicle dimensions
-    float height, length; 
+    // Step 3: a known vehicle keeps its stored dimensions
+    if (Vehicle::checkExist(licensePlate)) 
+    {
+        return createReservation(phoneNumber, sailingId,
+                                licensePlate, 0, 0);
+    }
+
+    // Step 4: check if the formats are correct before asking
+    // for anything else
+    if (!isValidNewVehicle(phoneNumber, licensePlate))
+    {
+        return false;
+    }
+
+    // Step 5: ask user if this is a special vehicle, and
+    // prompt for input if yes
+    // Variable to store user input for special vehicle check
+    char isSpecialInput; 
+    // Variables to store vehicle dimensions, in metres as
+    // entered
+    double height = Util::toMetres(REGULAR_VEHICLE_HEIGHT); 
+    double length = Util::toMetres(REGULAR_VEHICLE_LENGTH); 
 
-    // Flag to indicate if the vehicle is special
-    bool isSpecial = false; 
+    cout << "Is this a special vehicle? (y/n): " << endl;
+    cin >> isSpecialInput; // Get user input
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
-    // Check if the vehicle exists 
-    if (Vehicle::checkExist(licensePlate)) 
+    // Check if the user indicated a special vehicle
+    if (isSpecialInput == 'y' || isSpecialInput == 'Y') 
+    {
+        // Prompt user for vehicle dimensions
+        cout << "Enter height (in meters): ";
+        cin >> height; // Get height from user
+        cout << "Enter length (in meters): ";
+        cin >> length; // Get length from user
+    }
+
+    // Step 6: book with the dimensions given
+    return createReservation(phoneNumber, sailingId,
+                            licensePlate, 
+                            Util::toDecimetres(height), 
+                            Util::toDecimetres(length));
+}
+
+//*********************************************************
+// createReservation() (no prompt)
+//*********************************************************
+// Implements reservation logic including:
+// - sailing lookup
+// - duplicate reservation check
+// - vehicle existence and info collection
+// - sailing capacity check and deduction in one step
+// - logging the booking
+// - vehicle writing (if new) and reservation creation
+// Also adjusts space based on vehicle size.
+// in: sailingId, licensePlate, height and length for a new
+// vehicle (ignored for a known one)
+//*********************************************************
+bool OtherControls::createReservation(string &phoneNumber, 
+                    string &sailingId, string &licensePlate,
+                    int height, int length) 
+{
+    // No checkpoint may fall between the log entry and the
+    // changes it covers
+    shared_lock<shared_mutex> logged = 
+                            WriteAheadLog::beginOperation();
+    // Nothing else may change this sailing until the booking
+    // is written
+    unique_lock<mutex> stripe(Util::sailingStripe(sailingId));
+
+    // Step 1: check if sailing exists
+    if (!Sailing::checkExist(sailingId)) 
+    {
+        cout << "The sailing with id " << sailingId 
+            << " does not exist." << endl;
+        return false; // Return false if sailing does not exist
+    }
+
+    // Step 2: check if reservation already exists
+    if (Reservation::checkExist(licensePlate, sailingId)) 
+    {
+        cout << "This reservation already exists." << endl;
+        return false; 
+    }
+
+    // Step 3: check if the vehicle exists, fetching the whole
+    // record in the same lookup. The vehicle stripe keeps the
+    // lookup and the write below together, so two bookings
+    // for the same new vehicle cannot both add it.
+    unique_lock<mutex> vehicleStripe(
+                            Util::vehicleStripe(licensePlate));
+    Vehicle knownVehicle;
+    bool isNewVehicle = !Vehicle::find(licensePlate, knownVehicle);
+    if (!isNewVehicle) 
     {
-        // Vehicle exists, fetch its details
-        height = Vehicle::getHeight(licensePlate);
-        length = Vehicle::getLength(licensePlate);
+        // Vehicle exists, use its details
+        height = knownVehicle.height;
+        length = knownVehicle.length;
+        vehicleStripe.unlock();
     }
     else
     {
-        //Step 5: Check if the formats are correct
-        // Validate HCLL and LCLL values
-        if (phoneNumber.length() > PHONE_LENGTH) 
+        // Step 4: check if the formats are correct
+        if (!isValidNewVehicle(phoneNumber, licensePlate))
         {
-            cout << "Invalid format for phone number." << endl;
-            return false; // Invalid phone number
+            return false;
         }
-        else if (licensePlate.length() > LICENSE_PLATE_LENGTH 
-                || licensePlate.length() <= LICENSE_MIN_LENGTH)
-        {
-            cout << "Invalid format for License Plate." << endl;
-            return false; // Invalid License plate
-        }
-        for (char c : phoneNumber) {
-            if (!std::isdigit(c) && c != '-') {
-                cout << "Invalid format for phone number." 
-                        << endl;
-                // Found a non-digit and non-dash character
-                return false; 
-            }
-        }
-        
-        // Step 6: write the new vehicle record if it does not 
-        // already exist
-        // Ask user if this is a special vehicle, and prompt for
-        // input if yes
-        // Variable to store user input for special vehicle check
-        char isSpecialInput; 
-
-        cout << "Is this a special vehicle? (y/n): " << endl;
-        cin >> isSpecialInput; // Get user input
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-
-        // Check if the user indicated a special vehicle
-        if (isSpecialInput == 'y' || isSpecialInput == 'Y') 
-        {
-            // Set the flag to true for special vehicle
-            isSpecial = true; 
-            // Prompt user for vehicle dimensions
-            cout << "Enter height (in meters): ";
-            cin >> height; // Get height from user
-            cout << "Enter length (in meters): ";
-            cin >> length; // Get length from user
-            // Validate dimensions
-            /*
-            Height: Special vehicle height max 9.9 meters. 
-            Range 2.1 to 9.9m. Precision 0.1
-            Length: Special vehicle length max 99.9 meters. 
-            Range 7.1 to 99.9m. Precision 0.1
-            */
-            if (height < REGULAR_VEHICLE_HEIGHT 
-                || height > SPECIAL_VEHICLE_MAX_HEIGHT 
-                || length < REGULAR_VEHICLE_LENGTH 
-                || length > SPECIAL_VEHICLE_MAX_LENGTH)
-            {
-                cout << "Invalid height or length format."
-                 << endl;
-                return false; // Invalid height or length
-            }
 
-            // Validate phone number format
-            // Check if phone number exceeds maximum length
-            // Return false for invalid phone number
-            if (phoneNumber.length() > PHONE_LENGTH) 
-            {
-                cout << "Invalid phone number format."
-                    << " Must be max 14 digits." << endl;
-                return false; 
-            }
-        }
-        else
+        /*
+        Height: Special vehicle height max 9.9 meters. 
+        Range 2.1 to 9.9m. Precision 0.1
+        Length: Special vehicle length max 99.9 meters. 
+        Range 7.1 to 99.9m. Precision 0.1
+        */
+        if (height < REGULAR_VEHICLE_HEIGHT 
+            || height > SPECIAL_VEHICLE_MAX_HEIGHT 
+            || length < REGULAR_VEHICLE_LENGTH 
+            || length > SPECIAL_VEHICLE_MAX_LENGTH)
         {
-            // Default height for regular vehicles
-            height = REGULAR_VEHICLE_HEIGHT; 
-            // Default length for regular vehicles
-            length = REGULAR_VEHICLE_LENGTH; 
+            cout << "Invalid height or length format."
+             << endl;
+            return false; // Invalid height or length
         }
-
-        // Write special vehicle record to file
-        Vehicle::writeVehicle(licensePlate, phoneNumber,
-                                 height, length);
     }
 
-    // Step 7: check if sailing has space available for this 
-    // new reservation
-    if (Sailing::isSpaceAvailable(sailingId, isSpecial, 
-            length, height) == false) 
+    // Over-height vehicles, new or known, take the high
+    // ceiling lane; deleteReservation and
+    // Sailing::rebuildCapacity use the same rule
+    bool isSpecial = height > REGULAR_VEHICLE_HEIGHT; 
+
+    // Step 5: check the lane and reduce the space available
+    // in one step, so nothing can change in between
+    // Adjusts space based on vehicle type (high ceiling or
+    // low ceiling)
+    int remainingHRL, remainingLRL;
+    if (!Sailing::tryReserveSpace(sailingId, length, isSpecial,
+                                remainingHRL, remainingLRL)) 
     {
         cout << "No space available on sailing." << endl;
         return false; // No space available
     }
 
-    // Step 8: Reduce the space available, if reservation is 
-    // successful
-    // Adjusts space based on vehicle type (high ceiling or
-    // low ceiling)
-    Sailing::reduceSpace(sailingId, length, isSpecial); 
+    // Step 6: log the booking and wait for it to reach disk;
+    // bookings on other sailings share the sync
+    WriteAheadLog::Entry entry(WriteAheadLog::CREATE_RESERVATION);
+    Sailing::isValidSailingId(sailingId, entry.sailingKey);
+    WriteAheadLog::copyField(entry.phone, sizeof(entry.phone),
+                            phoneNumber);
+    WriteAheadLog::copyField(entry.license, 
+                            sizeof(entry.license), licensePlate);
+    entry.height = height;
+    entry.length = length;
+    if (!WriteAheadLog::commit(WriteAheadLog::append(entry)))
+    {
+        Sailing::addSpace(sailingId, length, isSpecial);
+        cout << "The booking could not be logged." << endl;
+        return false;
+    }
 
-    // Step 9: Create the reservation record
+    // Step 7: write the new vehicle record and create the
+    // reservation record
+    if (isNewVehicle)
+    {
+        Vehicle::writeVehicle(licensePlate, phoneNumber,
+                                 height, length);
+        vehicleStripe.unlock();
+    }
     Reservation::writeReservation(licensePlate, sailingId); 
+    SailingVersions::reserve(sailingId, isSpecial, length);
+
+    return true; // Reservation was logged and made
+}
 
-    return true; // Return true if reservation was successful
+//*********************************************************
+// isValidNewVehicle()
+//*********************************************************
+// Format checks for the phone number and license plate of
+// a vehicle that is not on file yet.
+// in: phoneNumber, licensePlate
+// out: true if both are valid
+//*********************************************************
+bool OtherControls::isValidNewVehicle(const string &phoneNumber,
+                                    const string &licensePlate)
+{
+    if (phoneNumber.length() > PHONE_LENGTH) 
+    {
+        cout << "Invalid format for phone number." << endl;
+        return false; // Invalid phone number
+    }
+    else if (licensePlate.length() > LICENSE_PLATE_LENGTH 
+            || licensePlate.length() <= LICENSE_MIN_LENGTH)
+    {
+        cout << "Invalid format for License Plate." << endl;
+        return false; // Invalid License plate
+    }
+    for (char c : phoneNumber) {
+        if (!std::isdigit(c) && c != '-') {
+            cout << "Invalid format for phone number." 
+                    << endl;
+            // Found a non-digit and non-dash character
+            return false; 
+        }
+    }
+    return true;
 }
 
 //*********************************************************
@@ -202,24 +299,43 @@ bool OtherControls::createReservation(string &phoneNumber,
 bool OtherControls::deleteReservation(string &license, 
                                     string &sailingId) 
 {
-    // Step 1: check if reservation exists
-    if (Reservation::checkExist(license, sailingId) == false) 
+    shared_lock<shared_mutex> logged = 
+                            WriteAheadLog::beginOperation();
+    unique_lock<mutex> stripe(Util::sailingStripe(sailingId));
+
+    // Step 1: check if reservation exists, and whether it
+    // was checked in
+    Reservation reservation;
+    if (!Reservation::find(license, sailingId, reservation)) 
     {
         cout << "Reservation not found in the system." << endl;
         return false; // Return false if reservation does not exist
     }
 
-    // Step 2: get length from the vehicle
-    // Create a Vehicle instance to fetch details
+    // Step 2: get length and height from the vehicle
+    // Create a Vehicle instance to hold the record
     Vehicle vehicle; 
 
-    // Fetch vehicle length from file using license key
-    float length = vehicle.getLength(license); 
-
-    // Step 3: get height from the vehicle
+    // Fetch the vehicle record from file using license key
+    if (!Vehicle::find(license, vehicle)) 
+    {
+        cout << "Vehicle with license " << license 
+            << " not found." << endl;
+        return false; // Cannot restore space without it
+    }
+    int length = vehicle.length; 
+    int height = vehicle.height; 
 
-    // Fetch vehicle height from file using license key
-    float height = vehicle.getHeight(license); 
+    // Step 3: log the cancellation
+    WriteAheadLog::Entry entry(WriteAheadLog::DELETE_RESERVATION);
+    Sailing::isValidSailingId(sailingId, entry.sailingKey);
+    WriteAheadLog::copyField(entry.license, 
+                            sizeof(entry.license), license);
+    if (!WriteAheadLog::commit(WriteAheadLog::append(entry)))
+    {
+        cout << "The cancellation could not be logged." << endl;
+        return false;
+    }
 
     // Step 4: remove the reservation record from the reservation
     // file
@@ -229,9 +345,12 @@ bool OtherControls::deleteReservation(string &license,
     }
 
     // Step 5: add the space back to the sailing
-    bool isSpecial = height > 2;
+    bool isSpecial = height > REGULAR_VEHICLE_HEIGHT;
     Sailing::addSpace(sailingId, length, isSpecial);
-    return true; // Return true if deletion was successful
+    SailingVersions::cancel(sailingId, isSpecial, length,
+                            reservation.onBoard);
+
+    return true; // Deletion was logged and made
 };
 
 //*********************************************************
@@ -242,14 +361,32 @@ bool OtherControls::deleteReservation(string &license,
 //*********************************************************
 bool OtherControls::checkIn(string &licensePlate, string &sailingId)
 {
+    shared_lock<shared_mutex> logged = 
+                            WriteAheadLog::beginOperation();
+    unique_lock<mutex> stripe(Util::sailingStripe(sailingId));
+
     // Step 1: Check if reservation exists
     if (!Reservation::checkExist(licensePlate, sailingId)) 
     {
         return false; // Reservation does not exist
     }
 
-    // Step 2: Set the reservation as checked in
-    Reservation::setCheckedIn(licensePlate); 
+    // Step 2: log the check-in
+    WriteAheadLog::Entry entry(WriteAheadLog::CHECK_IN);
+    Sailing::isValidSailingId(sailingId, entry.sailingKey);
+    WriteAheadLog::copyField(entry.license, 
+                            sizeof(entry.license), licensePlate);
+    if (!WriteAheadLog::commit(WriteAheadLog::append(entry)))
+    {
+        return false; // Check-in could not be logged
+    }
+
+    // Step 3: Set the reservation as checked in, counting it
+    // only the first time
+    if (Reservation::setCheckedIn(licensePlate, sailingId))
+    {
+        SailingVersions::checkIn(sailingId);
+    }
 
     return true; // Successfully checked in
 };
@@ -262,6 +399,11 @@ bool OtherControls::checkIn(string &licensePlate, string &sailingId)
 bool OtherControls::createVessel(string &vesselName, 
                                 int HCLL, int LCLL)
 {
+    shared_lock<shared_mutex> logged = 
+                            WriteAheadLog::beginOperation();
+    // The name check and the write happen as one step
+    unique_lock<OwnedMutex> lock(Util::vesselLock);
+
     // Step 1: Check if all the parameters are valid
     // Check if vessel name exceeds maximum length and
     // Validate HCLL and LCLL values
@@ -293,8 +435,24 @@ bool OtherControls::createVessel(string &vesselName,
         }
         else
         {
-            // Save vessel record
-            return Vessel::writeVessel(vesselName, HCLL, LCLL); 
+            // Step 4: log the new vessel; vessels are rare, so
+            // the catalog stays locked through the sync
+            WriteAheadLog::Entry entry(
+                                WriteAheadLog::CREATE_VESSEL);
+            WriteAheadLog::copyField(entry.vesselName,
+                            sizeof(entry.vesselName), vesselName);
+            entry.height = HCLL;
+            entry.length = LCLL;
+            if (!WriteAheadLog::commit(
+                                WriteAheadLog::append(entry)))
+            {
+                cout << "The vessel could not be logged." 
+                    << endl;
+                return false;
+            }
+
+            // Step 5: save vessel record
+            return Vessel::writeVessel(vesselName, HCLL, LCLL);
         }
     }
 };
\ No newline at end of file
@@ -7,6 +7,8 @@
 // entity classes like Vehicle, Sailing, Vessel, and Reservation
 // to manage ferry system operations.
 // July 22, 2025 Version 3 - Darpandeep Kaur
+// Oct 17, 2026 Version 4 - Team 18, createReservation
+// overload without prompts
 // ************************************************************
 
 #pragma once
@@ -19,8 +21,10 @@
 
 using namespace std;
 
-static float SPECIAL_VEHICLE_MAX_HEIGHT = 9.9;
-static float SPECIAL_VEHICLE_MAX_LENGTH = 999.9;
+// Largest special vehicle (9.9 m high, 999.9 m long) in
+// decimetres
+static int SPECIAL_VEHICLE_MAX_HEIGHT = 99;
+static int SPECIAL_VEHICLE_MAX_LENGTH = 9999;
 static int PHONE_NUMBER_MIN_LENGTH = 8;
 static int LICENSE_MIN_LENGTH = 1;
 
@@ -46,6 +50,21 @@ public:
     static bool createReservation(string &phoneNumber, 
                 string &licensePlate, string &sailingId);
 
+    //*********************************************************
+    // createReservation (no prompt)
+    //*********************************************************
+    // Purpose: Same as createReservation, but a new vehicle's
+    // dimensions are passed in instead of asked for. Vehicles
+    // larger than a regular one are booked as special.
+    // in: phoneNumber, sailingId, licensePlate, height and
+    // length in decimetres (ignored when the vehicle is
+    // already on file)
+    // out: returns true if reservation successfully made
+    //*********************************************************
+    static bool createReservation(string &phoneNumber, 
+                string &sailingId, string &licensePlate,
+                int height, int length);
+
     //*********************************************************
     // createVessel
     //*********************************************************
@@ -76,4 +95,9 @@ public:
     //*********************************************************
     static bool checkIn(string &licensePlate, 
                         std::string &sailingId);
+
+private:
+    // Format checks for a vehicle that is not on file yet
+    static bool isValidNewVehicle(const string &phoneNumber,
+                                const string &licensePlate);
 };
@@ -0,0 +1,929 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// RecordFile.h
+//*********************************************************
+// Purpose: Generic access to a .dat file of fixed-size
+// records. One RecordFile is declared per entity and
+// provides find, scan, parallelScan, updateAt, modifyAt,
+// append, eraseSwapLast, eraseInPlace and compact, keeping
+// an optional HashIndex in step, so the seek/read/compare
+// loops are written once for Sailing, Vehicle, Vessel and
+// Reservation.
+//
+// Other processes are kept out through the file's
+// FileLock: scan and parallelScan lock the slots they
+// read, other reads and in-place updates lock the record's
+// bytes, append locks the end of the file, and
+// eraseSwapLast and compact lock the whole file. Each
+// public method takes its own locks and releases them
+// before calling another, so one owner never holds
+// overlapping ranges. The ranges belong to the process,
+// not the thread, so a caller must hold the file's Util
+// lock (the FileLock's guard); each method asserts it does.
+//
+// T must provide:
+//   static const int RECORD_SIZE
+//   void readFromBuffer(const char *record)
+//   void writeToBuffer(char *record) const
+// KeyExtractor must provide:
+//   static const int LENGTH - key bytes
+//   static void extract(const char *record, char *key)
+//   static const bool HAS_TOMBSTONES
+//   static bool isLive(const char *record)
+// and, if HAS_TOMBSTONES, to use eraseInPlace:
+//   static void markDeleted(char *record)
+// Files without tombstones take the first two from
+// NoTombstones.
+//
+// A tombstone is a deleted record left in its slot. scan,
+// find and the index skip tombstones; compact reclaims them.
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, byte-range file locks
+// Oct 17, 2026 Version 3 - Team 18, tombstone deletes
+// Oct 17, 2026 Version 4 - Team 18, parallelScan
+// Oct 17, 2026 Version 5 - Team 18, index checked against
+// a fingerprint of the file; stale entries re-indexed
+// Oct 17, 2026 Version 6 - Team 18, assert the guard is held
+// Oct 17, 2026 Version 7 - Team 18, scan locks its slots
+// Oct 17, 2026 Version 8 - Team 18, eraseSwapLast checks
+// the key of the slot it erases
+//*********************************************************
+
+#pragma once
+
+#include "FileLock.h"
+#include "HashIndex.h"
+#include "RecordScanner.h"
+#include "Util.h"
+#include <cassert>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+//*********************************************************
+// NoTombstones
+//*********************************************************
+// Base for the KeyExtractor of a file whose records are
+// always live.
+//*********************************************************
+struct NoTombstones
+{
+    static const bool HAS_TOMBSTONES = false;
+
+    static bool isLive(const char *)
+    {
+        return true;
+    }
+};
+
+template <typename T, typename KeyExtractor>
+class RecordFile
+{
+public:
+    //*********************************************************
+    // Constructor
+    //*********************************************************
+    // in-out: file - shared stream for the .dat file
+    //         fileLock - byte-range locks for the same file
+    // in: fileName - name of the .dat file on disk
+    //     index - key -> slot index to maintain, or nullptr
+    //*********************************************************
+    RecordFile(fstream &file, FileLock &fileLock,
+                const string &fileName,
+                HashIndex *index = nullptr);
+
+    //*********************************************************
+    // count
+    //*********************************************************
+    // out: number of complete records in the file, including
+    // tombstones
+    //*********************************************************
+    int count();
+
+    //*********************************************************
+    // deadCount
+    //*********************************************************
+    // out: number of tombstones, as of openIndex plus those
+    // made and reclaimed through this RecordFile since
+    //*********************************************************
+    int deadCount() const;
+
+    //*********************************************************
+    // readAt
+    //*********************************************************
+    // Reads the record in a slot with a single read call.
+    // in: slot
+    // out: record, true if the slot holds a record
+    //*********************************************************
+    bool readAt(int slot, T &record);
+
+    //*********************************************************
+    // find
+    //*********************************************************
+    // Finds a record by key, through the index if there is
+    // one, otherwise by scanning the file. An index entry
+    // that points at another record re-indexes the file once;
+    // if the index is still out of step the file is scanned.
+    // in: key - KeyExtractor::LENGTH bytes
+    // out: record, slot of the record or -1 if not found
+    //*********************************************************
+    int find(const char *key, T &record);
+
+    //*********************************************************
+    // scan
+    //*********************************************************
+    // Visits every live record from firstSlot on, block by
+    // block, with the file locked shared from firstSlot on.
+    // visit therefore must not call the methods of this
+    // RecordFile that lock; callers collect what to change
+    // and change it once the scan returns.
+    // in: visit(const char *record, int slot) - returns false
+    //     to stop the scan; record is a view in file layout
+    //     firstSlot - slot to start from
+    //*********************************************************
+    template <typename Visitor>
+    void scan(Visitor visit, int firstSlot = 0);
+
+    //*********************************************************
+    // parallelScan
+    //*********************************************************
+    // Splits the file into one range of slots per worker and
+    // scans the ranges on their own threads, each through a
+    // stream of its own, so the shared stream is only used to
+    // count the records. Callers keep one partial result per
+    // worker and merge them once this returns.
+    // in: workers - number of threads, at least 1
+    //     visit(const char *record, int slot, int worker) -
+    //     called for every live record; calls with the same
+    //     worker come from one thread
+    //*********************************************************
+    template <typename Visitor>
+    void parallelScan(int workers, Visitor visit);
+
+    //*********************************************************
+    // updateAt
+    //*********************************************************
+    // Overwrites the record in a slot. The key must not
+    // change.
+    // in: slot, record
+    // out: true if written
+    //*********************************************************
+    bool updateAt(int slot, const T &record);
+
+    //*********************************************************
+    // modifyAt
+    //*********************************************************
+    // Read-modify-write of one record with its bytes locked
+    // throughout, so no other process can change the record
+    // in between.
+    // in: slot
+    //     change(T &record) - edits the record as read from
+    //     disk; returns false to leave it unwritten
+    // out: true if the record was written
+    //*********************************************************
+    template <typename Change>
+    bool modifyAt(int slot, Change change);
+
+    //*********************************************************
+    // append
+    //*********************************************************
+    // Adds a record at the end of the file and indexes it.
+    // in: record
+    // out: slot of the new record, or -1 on error
+    //*********************************************************
+    int append(const T &record);
+
+    //*********************************************************
+    // eraseSwapLast
+    //*********************************************************
+    // Deletes the record in a slot by moving the last record
+    // into it and shortening the file by one record. The
+    // slot is re-read under the lock, and nothing is erased
+    // unless it still holds key.
+    // in: slot, key (KeyExtractor::LENGTH bytes)
+    // out: moved - the record now in slot; returns the slot
+    // the moved record came from, slot itself if it was the
+    // last, or -1 if slot did not hold key
+    //*********************************************************
+    int eraseSwapLast(int slot, const char *key, T &moved);
+
+    //*********************************************************
+    // eraseInPlace
+    //*********************************************************
+    // Deletes the record in a slot by overwriting it with a
+    // tombstone. No other record moves and the file keeps its
+    // size, so only the record's bytes are locked.
+    // in: slot
+    // out: true if a live record was deleted
+    //*********************************************************
+    bool eraseInPlace(int slot);
+
+    //*********************************************************
+    // compact
+    //*********************************************************
+    // Removes records in one streaming pass: kept records
+    // are written back over the gaps and the file is
+    // truncated once. Tombstones are always removed.
+    // in: keep(const char *record, int newSlot) - returns
+    //     true to keep the record at newSlot
+    //     firstSlot - records before it are left untouched
+    // out: number of records removed
+    //*********************************************************
+    template <typename Predicate>
+    int compact(Predicate keep, int firstSlot = 0);
+
+    //*********************************************************
+    // openIndex
+    //*********************************************************
+    // Opens the index, rebuilding it from the file if it is
+    // missing or its fingerprint does not match the file.
+    //*********************************************************
+    void openIndex();
+
+    //*********************************************************
+    // closeIndex
+    //*********************************************************
+    void closeIndex();
+
+    //*********************************************************
+    // rebuildIndex
+    //*********************************************************
+    // Re-indexes every record in the file.
+    //*********************************************************
+    void rebuildIndex();
+
+private:
+    static const int RECORD_SIZE = T::RECORD_SIZE;
+    // findIndexed result for an entry that points at another
+    // record
+    static const int STALE_SLOT = -2;
+
+    fstream &file;
+    FileLock &fileLock;
+    string fileName;
+    HashIndex *index;
+    // Tombstones known to be in the file
+    int dead;
+
+    // Byte offset of a slot
+    static off_t offsetOf(int slot)
+    {
+        return static_cast<off_t>(slot) * RECORD_SIZE;
+    }
+
+    bool readBytes(int slot, char *record);
+    void writeBytes(int slot, const char *record);
+    // Index lookup of key, read into record; the slot, -1 if
+    // not indexed, or STALE_SLOT
+    int findIndexed(const char *key, char *record);
+    // Records the file's current size in the index
+    void noteSize();
+
+    // Checked before each range is locked: another thread
+    // locking or unlocking ranges at the same time would
+    // release this one's, since the process holds them all
+    void assertGuarded() const
+    {
+        assert(fileLock.guardHeld());
+    }
+};
+
+//*********************************************************
+// Constructor
+//*********************************************************
+template <typename T, typename KeyExtractor>
+RecordFile<T, KeyExtractor>::RecordFile(fstream &file,
+                                    FileLock &fileLock,
+                                    const string &fileName,
+                                    HashIndex *index)
+    : file(file), fileLock(fileLock), fileName(fileName),
+        index(index), dead(0)
+{
+}
+
+//*********************************************************
+// count()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+int RecordFile<T, KeyExtractor>::count()
+{
+    if (!file.is_open())
+    {
+        return 0;
+    }
+
+    file.clear();
+    file.seekg(0, ios::end);
+    return static_cast<int>(file.tellg() / RECORD_SIZE);
+}
+
+//*********************************************************
+// deadCount()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+int RecordFile<T, KeyExtractor>::deadCount() const
+{
+    return dead;
+}
+
+//*********************************************************
+// readAt()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+bool RecordFile<T, KeyExtractor>::readAt(int slot, T &record)
+{
+    char buffer[RECORD_SIZE];
+    assertGuarded();
+    RangeLock lock(fileLock, offsetOf(slot), RECORD_SIZE, false);
+    if (!readBytes(slot, buffer))
+    {
+        return false;
+    }
+
+    record.readFromBuffer(buffer);
+    return true;
+}
+
+//*********************************************************
+// find()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+int RecordFile<T, KeyExtractor>::find(const char *key,
+                                    T &record)
+{
+    char buffer[RECORD_SIZE];
+    char recordKey[KeyExtractor::LENGTH];
+
+    if (index != nullptr)
+    {
+        int slot = findIndexed(key, buffer);
+        if (slot == STALE_SLOT)
+        {
+            rebuildIndex();
+            slot = findIndexed(key, buffer);
+        }
+
+        if (slot >= 0)
+        {
+            record.readFromBuffer(buffer);
+        }
+        if (slot != STALE_SLOT)
+        {
+            return slot;
+        }
+        // Still stale: another process is moving records
+    }
+
+    int found = -1;
+    scan([&](const char *view, int slot)
+    {
+        KeyExtractor::extract(view, recordKey);
+        if (memcmp(recordKey, key, KeyExtractor::LENGTH) != 0)
+        {
+            return true; // Keep looking
+        }
+
+        record.readFromBuffer(view);
+        found = slot;
+        return false;
+    });
+
+    return found;
+}
+
+//*********************************************************
+// scan()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+template <typename Visitor>
+void RecordFile<T, KeyExtractor>::scan(Visitor visit,
+                                        int firstSlot)
+{
+    if (!file.is_open())
+    {
+        return;
+    }
+
+    assertGuarded();
+    RangeLock lock(fileLock, offsetOf(max(0, firstSlot)), 0,
+                    false);
+    RecordScanner scanner(file, RECORD_SIZE, firstSlot);
+    const char *record;
+
+    while ((record = scanner.next()) != nullptr)
+    {
+        if (!KeyExtractor::isLive(record))
+        {
+            continue;
+        }
+
+        if (!visit(record, scanner.slot()))
+        {
+            break;
+        }
+    }
+}
+
+//*********************************************************
+// parallelScan()
+// Each worker takes a shared lock on its own range only, so
+// the ranges never overlap
+//*********************************************************
+template <typename T, typename KeyExtractor>
+template <typename Visitor>
+void RecordFile<T, KeyExtractor>::parallelScan(int workers,
+                                                Visitor visit)
+{
+    if (!file.is_open())
+    {
+        return;
+    }
+
+    // The workers lock disjoint ranges on behalf of this
+    // thread, which holds the guard until they are done
+    assertGuarded();
+    int recordCount = count();
+    workers = max(1, min(workers, recordCount));
+    int perWorker = (recordCount + workers - 1) / workers;
+
+    auto scanRange = [&](int worker)
+    {
+        int firstSlot = worker * perWorker;
+        int endSlot = min(recordCount, firstSlot + perWorker);
+        if (firstSlot >= endSlot)
+        {
+            return;
+        }
+
+        fstream rangeFile(fileName, ios::in | ios::binary);
+        RangeLock lock(fileLock, offsetOf(firstSlot),
+                        offsetOf(endSlot) - offsetOf(firstSlot),
+                        false);
+        RecordScanner scanner(rangeFile, RECORD_SIZE, firstSlot);
+        const char *record;
+
+        while ((record = scanner.next()) != nullptr
+                && scanner.slot() < endSlot)
+        {
+            if (KeyExtractor::isLive(record))
+            {
+                visit(record, scanner.slot(), worker);
+            }
+        }
+    };
+
+    vector<thread> threads;
+    for (int worker = 1; worker < workers; worker++)
+    {
+        threads.emplace_back(scanRange, worker);
+    }
+    scanRange(0);
+
+    for (thread &worker : threads)
+    {
+        worker.join();
+    }
+}
+
+//*********************************************************
+// updateAt()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+bool RecordFile<T, KeyExtractor>::updateAt(int slot,
+                                        const T &record)
+{
+    if (!file.is_open() || slot < 0)
+    {
+        return false;
+    }
+
+    char buffer[RECORD_SIZE];
+    record.writeToBuffer(buffer);
+
+    assertGuarded();
+    RangeLock lock(fileLock, offsetOf(slot), RECORD_SIZE, true);
+    writeBytes(slot, buffer);
+    file.flush();
+    return true;
+}
+
+//*********************************************************
+// modifyAt()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+template <typename Change>
+bool RecordFile<T, KeyExtractor>::modifyAt(int slot,
+                                            Change change)
+{
+    if (!file.is_open() || slot < 0)
+    {
+        return false;
+    }
+
+    char buffer[RECORD_SIZE];
+    assertGuarded();
+    RangeLock lock(fileLock, offsetOf(slot), RECORD_SIZE, true);
+    if (!readBytes(slot, buffer))
+    {
+        return false;
+    }
+
+    T record;
+    record.readFromBuffer(buffer);
+    if (!change(record))
+    {
+        return false;
+    }
+
+    record.writeToBuffer(buffer);
+    writeBytes(slot, buffer);
+    file.flush();
+    return true;
+}
+
+//*********************************************************
+// append()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+int RecordFile<T, KeyExtractor>::append(const T &record)
+{
+    if (!file.is_open())
+    {
+        return -1;
+    }
+
+    char buffer[RECORD_SIZE];
+    record.writeToBuffer(buffer);
+
+    // Lock from the end of the file on; if another process
+    // appended while this one waited, move to the new end
+    assertGuarded();
+    int slot = count();
+    fileLock.lock(offsetOf(slot), 0, true);
+    for (int end = count(); end != slot; end = count())
+    {
+        fileLock.unlock(offsetOf(slot), 0);
+        slot = end;
+        fileLock.lock(offsetOf(slot), 0, true);
+    }
+
+    writeBytes(slot, buffer);
+    file.flush();
+    fileLock.unlock(offsetOf(slot), 0);
+
+    if (index != nullptr)
+    {
+        char key[KeyExtractor::LENGTH];
+        KeyExtractor::extract(buffer, key);
+        index->setDataSize(offsetOf(slot + 1));
+        index->insert(key, slot);
+    }
+
+    return slot;
+}
+
+//*********************************************************
+// eraseSwapLast()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+int RecordFile<T, KeyExtractor>::eraseSwapLast(int slot,
+                                                const char *key,
+                                                T &moved)
+{
+    // Records move and the file shrinks
+    assertGuarded();
+    RangeLock lock(fileLock, 0, 0, true);
+
+    int lastSlot = count() - 1;
+    char buffer[RECORD_SIZE];
+    char recordKey[KeyExtractor::LENGTH];
+
+    if (slot < 0 || slot > lastSlot || !readBytes(slot, buffer))
+    {
+        return -1;
+    }
+
+    // Another process may have moved a different record
+    // into the slot since the caller looked it up
+    KeyExtractor::extract(buffer, recordKey);
+    if (memcmp(recordKey, key, KeyExtractor::LENGTH) != 0)
+    {
+        return -1;
+    }
+
+    if (index != nullptr)
+    {
+        index->erase(recordKey);
+    }
+
+    int movedFrom = slot;
+    if (slot != lastSlot && readBytes(lastSlot, buffer))
+    {
+        writeBytes(slot, buffer);
+        moved.readFromBuffer(buffer);
+        movedFrom = lastSlot;
+
+        if (index != nullptr)
+        {
+            KeyExtractor::extract(buffer, recordKey);
+            index->insert(recordKey, slot);
+        }
+    }
+
+    Util::truncate(file, fileName,
+                    static_cast<streamoff>(lastSlot)
+                    * RECORD_SIZE);
+    noteSize();
+    return movedFrom;
+}
+
+//*********************************************************
+// eraseInPlace()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+bool RecordFile<T, KeyExtractor>::eraseInPlace(int slot)
+{
+    if (!file.is_open() || slot < 0)
+    {
+        return false;
+    }
+
+    char buffer[RECORD_SIZE];
+    assertGuarded();
+    RangeLock lock(fileLock, offsetOf(slot), RECORD_SIZE, true);
+    if (!readBytes(slot, buffer) || !KeyExtractor::isLive(buffer))
+    {
+        return false;
+    }
+
+    if (index != nullptr)
+    {
+        char key[KeyExtractor::LENGTH];
+        KeyExtractor::extract(buffer, key);
+        index->erase(key);
+    }
+
+    KeyExtractor::markDeleted(buffer);
+    writeBytes(slot, buffer);
+    file.flush();
+    dead++;
+    return true;
+}
+
+//*********************************************************
+// compact()
+// Reads blocks ahead of the write position, so records are
+// only ever written over slots that were already read
+//*********************************************************
+template <typename T, typename KeyExtractor>
+template <typename Predicate>
+int RecordFile<T, KeyExtractor>::compact(Predicate keep,
+                                        int firstSlot)
+{
+    // Records move and the file shrinks
+    assertGuarded();
+    RangeLock lock(fileLock, 0, 0, true);
+
+    int recordCount = count();
+    int recordsPerBlock = max(1, RecordScanner::BLOCK_SIZE
+                                / RECORD_SIZE);
+    vector<char> inBlock(static_cast<size_t>(recordsPerBlock)
+                            * RECORD_SIZE);
+    vector<char> outBlock(inBlock.size());
+    char key[KeyExtractor::LENGTH];
+    int reclaimed = 0;
+
+    int readSlot = max(0, firstSlot);
+    int writeSlot = readSlot;
+
+    while (readSlot < recordCount)
+    {
+        int blockRecords = min(recordsPerBlock,
+                                recordCount - readSlot);
+
+        file.clear();
+        file.seekg(static_cast<streamoff>(readSlot)
+                    * RECORD_SIZE, ios::beg);
+        file.read(inBlock.data(),
+                    static_cast<streamsize>(blockRecords)
+                    * RECORD_SIZE);
+
+        int kept = 0;
+        for (int i = 0; i < blockRecords; i++)
+        {
+            const char *record = inBlock.data()
+                        + static_cast<size_t>(i) * RECORD_SIZE;
+            int newSlot = writeSlot + kept;
+
+            // Tombstones are not in the index; just drop them
+            if (!KeyExtractor::isLive(record))
+            {
+                reclaimed++;
+                continue;
+            }
+
+            if (index != nullptr)
+            {
+                KeyExtractor::extract(record, key);
+            }
+
+            if (!keep(record, newSlot))
+            {
+                if (index != nullptr)
+                {
+                    index->erase(key);
+                }
+                continue;
+            }
+
+            if (index != nullptr && newSlot != readSlot + i)
+            {
+                index->insert(key, newSlot);
+            }
+
+            memcpy(outBlock.data()
+                    + static_cast<size_t>(kept) * RECORD_SIZE,
+                    record, RECORD_SIZE);
+            kept++;
+        }
+
+        // Only write when something actually moved
+        if (kept > 0 && (writeSlot != readSlot
+                        || kept != blockRecords))
+        {
+            file.clear();
+            file.seekp(static_cast<streamoff>(writeSlot)
+                        * RECORD_SIZE, ios::beg);
+            file.write(outBlock.data(),
+                        static_cast<streamsize>(kept)
+                        * RECORD_SIZE);
+        }
+
+        writeSlot += kept;
+        readSlot += blockRecords;
+    }
+
+    if (writeSlot < recordCount)
+    {
+        Util::truncate(file, fileName,
+                        static_cast<streamoff>(writeSlot)
+                        * RECORD_SIZE);
+    }
+
+    noteSize();
+    dead = max(0, dead - reclaimed);
+    return recordCount - writeSlot;
+}
+
+//*********************************************************
+// openIndex()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+void RecordFile<T, KeyExtractor>::openIndex()
+{
+    if (index == nullptr || !file.is_open())
+    {
+        return;
+    }
+
+    // The index holds one entry per live record; the same
+    // pass sums their checksums
+    int recordCount = count();
+    int liveCount = 0;
+    unsigned int keySum = 0;
+    char key[KeyExtractor::LENGTH];
+    scan([&](const char *record, int slot)
+    {
+        KeyExtractor::extract(record, key);
+        keySum += index->entryChecksum(key, slot);
+        liveCount++;
+        return true;
+    });
+    dead = recordCount - liveCount;
+
+    if (!index->open(liveCount, offsetOf(recordCount), keySum))
+    {
+        rebuildIndex();
+    }
+}
+
+//*********************************************************
+// closeIndex()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+void RecordFile<T, KeyExtractor>::closeIndex()
+{
+    if (index != nullptr)
+    {
+        index->close();
+    }
+}
+
+//*********************************************************
+// rebuildIndex()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+void RecordFile<T, KeyExtractor>::rebuildIndex()
+{
+    if (index == nullptr)
+    {
+        return;
+    }
+
+    index->clear(count());
+
+    char key[KeyExtractor::LENGTH];
+    scan([&](const char *record, int slot)
+    {
+        KeyExtractor::extract(record, key);
+        index->insert(key, slot);
+        return true;
+    });
+    noteSize();
+}
+
+//*********************************************************
+// readBytes()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+bool RecordFile<T, KeyExtractor>::readBytes(int slot,
+                                            char *record)
+{
+    if (!file.is_open() || slot < 0)
+    {
+        return false;
+    }
+
+    file.clear();
+    file.seekg(static_cast<streamoff>(slot) * RECORD_SIZE,
+                ios::beg);
+    file.read(record, RECORD_SIZE);
+
+    if (file.gcount() != RECORD_SIZE)
+    {
+        file.clear();
+        return false;
+    }
+    return true;
+}
+
+//*********************************************************
+// findIndexed()
+// Index lookups are verified against the stored key, so a
+// stale index can never return the wrong record
+//*********************************************************
+template <typename T, typename KeyExtractor>
+int RecordFile<T, KeyExtractor>::findIndexed(const char *key,
+                                            char *record)
+{
+    int slot = index->find(key);
+    if (slot < 0)
+    {
+        return -1;
+    }
+
+    char recordKey[KeyExtractor::LENGTH];
+    assertGuarded();
+    RangeLock lock(fileLock, offsetOf(slot), RECORD_SIZE, false);
+    if (!readBytes(slot, record) || !KeyExtractor::isLive(record))
+    {
+        return STALE_SLOT;
+    }
+
+    KeyExtractor::extract(record, recordKey);
+    if (memcmp(recordKey, key, KeyExtractor::LENGTH) != 0)
+    {
+        return STALE_SLOT;
+    }
+    return slot;
+}
+
+//*********************************************************
+// noteSize()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+void RecordFile<T, KeyExtractor>::noteSize()
+{
+    if (index != nullptr)
+    {
+        index->setDataSize(offsetOf(count()));
+    }
+}
+
+//*********************************************************
+// writeBytes()
+//*********************************************************
+template <typename T, typename KeyExtractor>
+void RecordFile<T, KeyExtractor>::writeBytes(int slot,
+                                        const char *record)
+{
+    file.clear();
+    file.seekp(static_cast<streamoff>(slot) * RECORD_SIZE,
+                ios::beg);
+    file.write(record, RECORD_SIZE);
+}
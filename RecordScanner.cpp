@@ -0,0 +1,92 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// RecordScanner.cpp
+//*********************************************************
+// Purpose: Implements the block-buffered record scanner.
+// Each block is read from an explicit offset, so code that
+// seeks or writes the same stream between calls to next()
+// does not disturb the scan.
+// Oct 17, 2026 Version 1 - Team 18
+//*********************************************************
+
+#include "RecordScanner.h"
+
+using namespace std;
+
+//*********************************************************
+// Constructor
+//*********************************************************
+RecordScanner::RecordScanner(fstream &file, int recordSize,
+                            int firstSlot)
+    : file(file)
+{
+    this->recordSize = recordSize;
+    recordsPerBlock = BLOCK_SIZE / recordSize;
+    if (recordsPerBlock < 1)
+    {
+        recordsPerBlock = 1;
+    }
+
+    buffer.resize(static_cast<size_t>(recordsPerBlock) 
+                    * recordSize);
+    blockSlot = firstSlot;
+    recordsInBlock = 0;
+    position = 0;
+}
+
+//*********************************************************
+// next()
+// Returns the next record, reading a new block when the
+// current one is used up
+//*********************************************************
+const char *RecordScanner::next()
+{
+    if (position >= recordsInBlock)
+    {
+        blockSlot += recordsInBlock;
+        if (!readBlock())
+        {
+            return nullptr;
+        }
+    }
+
+    const char *record = buffer.data() 
+                        + static_cast<size_t>(position) 
+                        * recordSize;
+    position++;
+    return record;
+}
+
+//*********************************************************
+// slot()
+//*********************************************************
+int RecordScanner::slot() const
+{
+    return blockSlot + position - 1;
+}
+
+//*********************************************************
+// readBlock()
+// Reads up to recordsPerBlock records starting at
+// blockSlot; a partial record at the end is ignored
+//*********************************************************
+bool RecordScanner::readBlock()
+{
+    recordsInBlock = 0;
+    position = 0;
+
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file.clear();
+    file.seekg(static_cast<streamoff>(blockSlot) * recordSize,
+                ios::beg);
+    file.read(buffer.data(), buffer.size());
+    recordsInBlock = static_cast<int>(file.gcount() 
+                                        / recordSize);
+    file.clear();
+
+    return recordsInBlock > 0;
+}
@@ -0,0 +1,64 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// RecordScanner.h
+//*********************************************************
+// Purpose: Block-buffered reader for the fixed-size records
+// in the .dat files. Reads large blocks with one call and
+// hands records out as pointers into the block, so a scan
+// costs one read per block instead of several stream reads
+// per record.
+// Oct 17, 2026 Version 1 - Team 18
+//*********************************************************
+
+#pragma once
+
+#include <fstream>
+#include <vector>
+
+using namespace std;
+
+class RecordScanner
+{
+public:
+    // Bytes read from the file per block
+    static const int BLOCK_SIZE = 64 * 1024;
+
+    //*********************************************************
+    // Constructor
+    //*********************************************************
+    // in-out: file - open binary stream to scan
+    // in: recordSize - bytes per record
+    //     firstSlot - record number to start from
+    //*********************************************************
+    RecordScanner(fstream &file, int recordSize, 
+                    int firstSlot = 0);
+
+    //*********************************************************
+    // next
+    //*********************************************************
+    // Moves to the next complete record.
+    // out: pointer to the record bytes, valid until the next
+    // call, or nullptr at end of file
+    //*********************************************************
+    const char *next();
+
+    //*********************************************************
+    // slot
+    //*********************************************************
+    // out: record number of the record last returned by next
+    //*********************************************************
+    int slot() const;
+
+private:
+    fstream &file;
+    int recordSize;
+    int recordsPerBlock;
+    vector<char> buffer;
+    // Slot of the first record held in buffer
+    int blockSlot;
+    // Records held in buffer and index of the next one
+    int recordsInBlock;
+    int position;
+
+    bool readBlock();
+};
@@ -10,6 +10,14 @@
 //**********************************************************
 // Version History:
 // ver. 2 - July 23, 2025 by Saman and Noble
+// ver. 3 - Oct 17, 2026 by Team 18, sailings stored as their
+// 32-bit encoded key
+// ver. 4 - Oct 17, 2026 by Team 18, find, and check-in by
+// license and sailing
+// ver. 5 - Oct 17, 2026 by Team 18, deletes check the slot
+// still holds the reservation
+// ver. 6 - Oct 17, 2026 by Team 18, change stamp shared with
+// other processes
 //**********************************************************
 
 #include "Reservation.h"
@@ -22,9 +30,32 @@
 #include <iomanip>
 #include <cstring>
 #include <sstream>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
 
 using namespace std;
 
+//**********************************************************
+// Secondary index of sailing key -> reservation slots
+//**********************************************************
+unordered_map<uint32_t, vector<int>> Reservation::index;
+
+//**********************************************************
+// Change stamp of reservation.dat, and the value the index
+// was last brought up to date with
+//**********************************************************
+int Reservation::stampFd = -1;
+FileLock Reservation::stampLock(&Util::reservationLock);
+uint64_t Reservation::indexStamp = 0;
+
+//**********************************************************
+// reservation.dat records
+//**********************************************************
+RecordFile<Reservation, ReservationKey> Reservation::records(
+                    Util::reservationFile, Util::reservationFileLock,
+                    "reservation.dat");
+
 //**********************************************************
 // Default Constructor
 // Initializes the reservation with default values
@@ -32,7 +63,7 @@ using namespace std;
 Reservation::Reservation()
 {
     strcpy(license, "");
-    strcpy(sailingId, "");
+    sailingKey = 0;
     onBoard = false; // Default to not on board
 }
 
@@ -44,10 +75,9 @@ Reservation::Reservation()
 Reservation::Reservation(const string &license, 
                 const string &sailingId, const bool &onBoard)
 {
-    strcpy(this->license, license.c_str()); 
-    strcpy(this->sailingId, sailingId.c_str());
-    this->sailingId[SAILING_ID_LENGTH] = '\0'; 
+    strncpy(this->license, license.c_str(), LICENSE_LENGTH); 
     this->license[LICENSE_LENGTH] = '\0'; 
+    sailingKey = keyOf(sailingId); 
     this->onBoard = onBoard; // Set onBoard status
 }
 
@@ -62,7 +92,8 @@ void Reservation::writeToFile(fstream &file) const
     if (file.is_open()) // Check if the file is open
     {
         file.write(license, sizeof(license)); 
-        file.write(sailingId, sizeof(sailingId)); 
+        file.write(reinterpret_cast<const char *>(&sailingKey),
+                     sizeof(sailingKey)); 
         file.write(reinterpret_cast<const char *>(&onBoard),
                      sizeof(onBoard)); // Write onBoard flag
         file.flush(); // Ensure it’s flushed to disk
@@ -76,19 +107,30 @@ void Reservation::writeToFile(fstream &file) const
 
 //**********************************************************
 // writeReservation()
-// Appends a new reservation to the binary file.
+// Appends a new reservation to the binary file and adds
+// its slot to the sailing's index entry.
 //**********************************************************
 bool Reservation::writeReservation(const string &license, 
                                 const string &sailingId)
 {
+    lock_guard<OwnedMutex> lock(Util::reservationLock);
     // Create a new reservation with onBoard = false
     Reservation reservation(license, sailingId, false); 
-    Util::reservationFile.clear(); // Clear file flags
-    // Move to end of the file
-    Util::reservationFile.seekg(0, ios::end); 
-    // Write the reservation to the file
-    reservation.writeToFile(Util::reservationFile); 
-    Util::reservationFile.flush(); // Save to disk
+    if (reservation.sailingKey == 0) 
+    {
+        return false; // Not a valid sailing ID
+    }
+    refreshIndex(); 
+    // Append the reservation and save to disk
+    int slot = records.append(reservation); 
+    if (slot < 0) 
+    {
+        return false; // File is not open
+    }
+
+    // Index the new record under its sailing
+    index[reservation.sailingKey].push_back(slot); 
+    noteChange(); 
 
     return true; // Return true indicating success
 }
@@ -103,7 +145,8 @@ bool Reservation::readFromFile(fstream &file)
     if (file.is_open()) // Check if the file is open
     {
         file.read(license, sizeof(license)); 
-        file.read(sailingId, sizeof(sailingId)); 
+        file.read(reinterpret_cast<char *>(&sailingKey), 
+                        sizeof(sailingKey)); 
         file.read(reinterpret_cast<char *>(&onBoard), 
                         sizeof(onBoard)); 
         return true; // Return true if read was successful
@@ -116,14 +159,41 @@ bool Reservation::readFromFile(fstream &file)
     }
 }
 
+//**********************************************************
+// readFromBuffer()
+// Copies the fields out of a record in file layout.
+//**********************************************************
+void Reservation::readFromBuffer(const char *record)
+{
+    memcpy(license, record, sizeof(license)); 
+    record += sizeof(license); 
+    memcpy(&sailingKey, record, sizeof(sailingKey)); 
+    record += sizeof(sailingKey); 
+    memcpy(&onBoard, record, sizeof(onBoard)); 
+}
+
+//**********************************************************
+// writeToBuffer()
+// Copies the fields into a record in file layout.
+//**********************************************************
+void Reservation::writeToBuffer(char *record) const
+{
+    memcpy(record, license, sizeof(license)); 
+    record += sizeof(license); 
+    memcpy(record, &sailingKey, sizeof(sailingKey)); 
+    record += sizeof(sailingKey); 
+    memcpy(record, &onBoard, sizeof(onBoard)); 
+}
+
 //**********************************************************
 // checkExist()
 // Returns true if a reservation exists for the given
-// sailingId + license.
+// sailingId + license. Only that sailing's records are read.
 //**********************************************************
 bool Reservation::checkExist(const string &license, 
                             const string &sailingId)
 {
+    lock_guard<OwnedMutex> lock(Util::reservationLock);
     // Check if the reservation file is open
     if (!Util::reservationFile.is_open()) 
     {
@@ -132,33 +202,25 @@ bool Reservation::checkExist(const string &license,
         return false; // Return false if file is not open
     }
 
-    Util::reservationFile.clear(); // Reset flags
-    // Go to start of the file
-    Util::reservationFile.seekg(0, ios::beg); 
-
-    // Create a Reservation instance to read records
-    Reservation reservation; 
-
-    // Loop while there is data to read
-    while (!Util::reservationFile.eof())
-    {
-        // Read a reservation record
-        reservation.readFromFile(Util::reservationFile); 
-
-        // Compare the primary key (here it is a composite 
-        // key of license and sailingId)
-        if (strncmp(reservation.license, license.c_str(),
-            LICENSE_LENGTH) == 0 && 
-            strncmp(reservation.sailingId, 
-            sailingId.c_str(), SAILING_ID_LENGTH) == 0)
-        {
-            // Return true if a matching reservation is found
-            return true; 
-        }
-    }
+    // Look for the composite key (license and sailingId)
+    // among the sailing's indexed reservations
+    refreshIndex(); 
+    return findSlot(license, keyOf(sailingId)) >= 0; 
+}
 
-    // Return false if no matching reservation is found
-    return false; 
+//**********************************************************
+// find()
+// Reads a reservation found through the sailing's index
+// entry.
+//**********************************************************
+bool Reservation::find(const string &license, 
+                        const string &sailingId, 
+                        Reservation &found)
+{
+    lock_guard<OwnedMutex> lock(Util::reservationLock);
+    refreshIndex(); 
+    int slot = findSlot(license, keyOf(sailingId)); 
+    return slot >= 0 && readAt(slot, found); 
 }
 
 //**********************************************************
@@ -168,7 +230,8 @@ bool Reservation::checkExist(const string &license,
 string Reservation::toString() const
 {
     stringstream ss; // Create a string stream for formatting
-    ss << "Reservation: " << license << ", " << sailingId 
+    ss << "Reservation: " << license << ", " 
+    << Sailing::sailingIdFromKey(sailingKey) 
     << ", onBoard: " << (onBoard ? "Yes" : "No") << endl; 
     return ss.str(); // Return the formatted string
 }
@@ -180,6 +243,7 @@ string Reservation::toString() const
 int Reservation::getTotalReservationsOnSailing(
                     const string &sailingId)
 {
+    lock_guard<OwnedMutex> lock(Util::reservationLock);
     // Check if the reservation file is open
     if (!Util::reservationFile.is_open()) 
     {
@@ -187,44 +251,58 @@ int Reservation::getTotalReservationsOnSailing(
         return -1; // Return -1 to indicate an error
     }
 
-    Util::reservationFile.clear(); // Clear any error flags
-    
-    // Start at file beginning
-    Util::reservationFile.seekg(0, ios::beg); 
+    // The index holds one slot per reservation on the sailing
+    refreshIndex(); 
+    auto entry = index.find(keyOf(sailingId)); 
+    if (entry == index.end()) 
+    {
+        return 0; // No reservations on this sailing
+    }
 
-    // Create a Reservation instance to read records
-    Reservation reservation; 
-    int count = 0; // Initialize count of reservations
+    // Return total reservations for the sailing ID
+    return static_cast<int>(entry->second.size()); 
+}
+
+//**********************************************************
+// getReservationsOnSailing()
+// Reads every reservation on a sailing straight from its
+// indexed slots.
+//**********************************************************
+vector<Reservation> Reservation::getReservationsOnSailing(
+                    const string &sailingId)
+{
+    lock_guard<OwnedMutex> lock(Util::reservationLock);
+    vector<Reservation> reservations; 
 
-    // Check for end of file and Loop through records 
-    while (Util::reservationFile.peek() != EOF) 
+    refreshIndex(); 
+    auto entry = index.find(keyOf(sailingId)); 
+    if (entry == index.end()) 
     {
-        // Read a reservation record
-        reservation.readFromFile(Util::reservationFile); 
+        return reservations; // No reservations on this sailing
+    }
 
-        // Check if the sailingId matches
-        if (strcmp(reservation.sailingId, 
-            sailingId.c_str()) == 0) 
+    Reservation reservation; 
+    for (int slot : entry->second) 
+    {
+        if (readAt(slot, reservation)) 
         {
-            // Increment count for each matching reservation
-            count++; 
+            reservations.push_back(reservation); 
         }
     }
 
-    // Return total reservations for the sailing ID
-    return count; 
+    return reservations; 
 }
 
 //**********************************************************
 // removeReservation()
 // Removes a reservation with matching sailingId and license.
+// The last record is moved into the freed slot and the
+// file is shortened by one record.
 //**********************************************************
 bool Reservation::removeReservation(const string &license, 
                                     const string &sailingId)
 {
-    // Create a Reservation instance to read records
-    Reservation reservation; 
-
+    lock_guard<OwnedMutex> lock(Util::reservationLock);
     // Check if the reservation file is open
     if (!Util::reservationFile.is_open()) 
     {
@@ -232,106 +310,67 @@ bool Reservation::removeReservation(const string &license,
         return false; // Return false if file is not open
     }
 
-    Util::reservationFile.clear(); // Clear any error flags
-
-    // Move read pointer to beginning
-    Util::reservationFile.seekg(0, ios::beg); 
-
-    // Variable to store current position in the file
-    streampos currentPos; 
+    // Step 1: Find the matching record through the index
+    refreshIndex(); 
+    Reservation match(license, sailingId, false); 
+    int matchSlot = findSlot(license, match.sailingKey); 
+    if (matchSlot < 0) // Check if no match was found
+    {
+        cout << "Reservation not found." << endl;
+        // Return false if no matching reservation is found
+        return false; 
+    }
 
-    // Variable to store position of matching record
-    streampos matchPos = -1; 
+    // Step 2: Overwrite the matched record with the last one
+    // and shorten the file in place. The record is only
+    // erased if the slot still holds it; another process may
+    // have moved it, and then the index is rebuilt and the
+    // erase tried once more.
+    char key[ReservationKey::LENGTH]; 
+    char buffer[RECORD_SIZE]; 
+    match.writeToBuffer(buffer); 
+    ReservationKey::extract(buffer, key); 
 
-    // Step 1:Find Matching record and Loop till end of file
-    while (!Util::reservationFile.eof()) 
+    Reservation lastRecord; 
+    int lastSlot = records.eraseSwapLast(matchSlot, key, 
+                                        lastRecord); 
+    if (lastSlot < 0) 
     {
-        // Read a reservation record
-        reservation.readFromFile(Util::reservationFile); 
-        // Get current position
-        currentPos = Util::reservationFile.tellg() - 
-                        static_cast<streamoff>(RECORD_SIZE); 
-
-        // Check if the current record matches the given 
-        // license and sailingId
-        if (strcmp(reservation.license, 
-            license.c_str()) == 0 &&
-            strcmp(reservation.sailingId, 
-            sailingId.c_str()) == 0)
+        openIndex(); 
+        matchSlot = findSlot(license, match.sailingKey); 
+        if (matchSlot >= 0) 
         {
-            // Store position of matching record
-            matchPos = currentPos; 
-            break; // Exit loop if match is found
+            lastSlot = records.eraseSwapLast(matchSlot, key, 
+                                            lastRecord); 
         }
     }
-    if (matchPos == -1) // Check if no match was found
+    if (lastSlot < 0) 
     {
         cout << "Reservation not found." << endl;
-        // Return false if no matching reservation is found
         return false; 
     }
+    noteChange(); 
 
-    // Step 2: Determine last record position
-    Util::reservationFile.clear(); // Clear any error flags
-    // Move to end of the file
-    Util::reservationFile.seekg(0, ios::end); 
-    // Get total file size
-    streamoff fileSize = Util::reservationFile.tellg(); 
-    // Calculate position of the last record
-    streamoff lastRecordPos = fileSize - RECORD_SIZE; 
-
-    // Check if the matched record is the last one
-    if (matchPos == lastRecordPos) 
+    // Step 3: The matched record leaves the sailing's index
+    // entry, and the moved record now lives in its slot
+    moveSlot(match.sailingKey, matchSlot, -1); 
+    if (lastSlot != matchSlot) 
     {
-        Util::reservationFile.close(); // Close the file
-        // Truncate the file to remove the last record
-        Util::truncate("reservation.dat", lastRecordPos); 
-        // Reopen the file
-        Util::reservationFile.open("reservation.dat", ios::in 
-                                    | ios::out | ios::binary); 
-        return true; // Return true indicating success
+        moveSlot(lastRecord.sailingKey, lastSlot, matchSlot); 
     }
 
-    // Step 3: Read last record
-    // Create a Reservation instance for the last record
-    Reservation lastRecord; 
-    Util::reservationFile.clear(); // Clear any error flags
-    // Move to the last record's position
-    Util::reservationFile.seekg(lastRecordPos, ios::beg); 
-    // Read last record data
-    Util::reservationFile.read(
-        reinterpret_cast<char *>(&lastRecord), RECORD_SIZE); 
-
-    // Step 4: Overwrite matched record with last record
-    Util::reservationFile.clear(); // Clear any error flags
-    // Move to the position of the matched record
-    Util::reservationFile.seekp(matchPos, ios::beg); 
-    // Write last record data to matched position
-    Util::reservationFile.write(
-        reinterpret_cast<const char *>(&lastRecord), RECORD_SIZE); 
-
-    // Step 5: Truncate the file
-    Util::reservationFile.close(); // Close the file
-    // Truncate the file to remove the last record
-    Util::truncate("reservation.dat", fileSize 
-                        - RECORD_SIZE); 
-    // Reopen the file
-    Util::reservationFile.open("reservation.dat", ios::in 
-                                | ios::out | ios::binary); 
-
     return true; // Return true indicating success
 }
 
 //**********************************************************
 // removeReservationsOnSailing()
-// Removes all reservations that match the given sailing ID.
+// Removes all reservations that match the given sailing ID
+// in one streaming compaction pass with a single truncate.
 //**********************************************************
-
-// TEST ABOVE FIRST, THIS WITH 1-1 LOOP AT FRONT & END LATER, 
-// OTHERWISE TOO MANY PRINTS
 bool Reservation::removeReservationsOnSailing(
                     const std::string &sailingId)
 {
+    lock_guard<OwnedMutex> lock(Util::reservationLock);
     // Check if the reservation file is open
     if (!Util::reservationFile.is_open()) 
     {
@@ -339,45 +378,57 @@ bool Reservation::removeReservationsOnSailing(
         return false; // Return false if file is not open
     }
 
-    // Create a Reservation instance to read records
-    Reservation reservation; 
-    // Flag to indicate if a matching reservation is found
-    bool foundAMatchingReservation = false; 
+    refreshIndex(); 
+    uint32_t sailingKey = keyOf(sailingId); 
+    auto entry = index.find(sailingKey); 
 
-    // Clear any error flags
-    Util::reservationFile.clear(); 
-    // Move read pointer to beginning
-    Util::reservationFile.seekg(0, ios::beg); 
-
-    // Read the records until the end of the file
-    // Loop until end of file
-    while (!Util::reservationFile.eof()) 
+    // Check if no matching reservations were found
+    if (entry == index.end()) 
     {
-        // Read a reservation record
-        reservation.readFromFile(Util::reservationFile); 
+        cout <<"No reservations found for this sailing ID: " 
+        << sailingId<<"\n Hence, no reservations deletions "
+        << "happened." << endl;
+        return true; 
+    }
 
-        // Check if the sailingId matches
-        if (strcmp(reservation.sailingId, 
-            sailingId.c_str()) == 0) 
-        {
-            // Found at least one matching reservation
-            foundAMatchingReservation = true; 
+    // Records before the sailing's first slot stay where they
+    // are, so compaction starts there
+    int firstSlot = *min_element(entry->second.begin(), 
+                                entry->second.end()); 
+
+    // Kept records from firstSlot on move, so their slots are
+    // dropped here and re-added as the pass writes them
+    index.erase(entry); 
+    for (auto &sailing : index) 
+    {
+        vector<int> &slots = sailing.second; 
+        slots.erase(remove_if(slots.begin(), slots.end(), 
+                    [firstSlot](int slot) 
+                    { return slot >= firstSlot; }), 
+                    slots.end()); 
+    }
 
-            // Extract the license number of the reservation
-            // record
-            string license(reservation.license); 
+    records.compact([&](const char *record, int newSlot) 
+    {
+        // Stored as license then sailing key
+        uint32_t recordKey; 
+        memcpy(&recordKey, record + LICENSE_LENGTH + 1, 
+                sizeof(recordKey)); 
 
-            // Call removeReservation using both parameters
-            removeReservation(license, sailingId); 
+        if (recordKey == sailingKey) 
+        {
+            return false; // Drop this reservation
         }
-    }
 
-    // Check if no matching reservations were found
-    if (!foundAMatchingReservation) 
+        index[recordKey].push_back(newSlot); 
+        return true; 
+    }, firstSlot); 
+    noteChange(); 
+
+    // Drop sailings left without any reservations
+    for (auto it = index.begin(); it != index.end(); ) 
     {
-        cout <<"No reservations found for this sailing ID: " 
-        << sailingId<<"\n Hence, no reservations deletions "
-        << "happened." << endl;
+        it = it->second.empty() ? index.erase(it) : next(it); 
     }
 
     // Return true indicating the operation was completed
@@ -387,55 +438,60 @@ bool Reservation::removeReservationsOnSailing(
 //**********************************************************
 // setCheckedIn()
 // Marks a reservation as checked in and update the checked
-// -in value in the binary file record.
+// -in value in the binary file record. Only the sailing's
+// indexed records are searched.
 //**********************************************************
-void Reservation::setCheckedIn(const string &license)
+bool Reservation::setCheckedIn(const string &license,
+                                const string &sailingId)
 {
+    lock_guard<OwnedMutex> lock(Util::reservationLock);
     // Check if the reservation file is open
     if (!Util::reservationFile.is_open()) 
     {
         cout << "Error opening Reservation File!" << endl;
-        return; // Exit if file is not open
+        return false; // Exit if file is not open
     }
-    // Clear any error flags
-    Util::reservationFile.clear(); 
-    // Move read pointer to beginning
-    Util::reservationFile.seekg(0, ios::beg); 
 
-    // Create a Reservation instance to read records
-    Reservation reservation; 
+    // Find the reservation among the sailing's records
+    refreshIndex(); 
+    uint32_t sailingKey = keyOf(sailingId); 
+    int matchSlot = findSlot(license, sailingKey); 
 
-    // Loop through records
-    while (reservation.readFromFile(Util::reservationFile)) 
+    if (matchSlot < 0) 
     {
-        // Get start position of the current record
-        streampos recordStartPos = 
-        Util::reservationFile.tellg() 
-        - static_cast<streamoff>(RECORD_SIZE); 
+        // Error message if reservation not found
+        cout << "Reservation with license " << license 
+            << " not found." << endl; 
+        return false; 
+    }
 
-        // Check if the license matches
-        if (strcmp(reservation.license, 
-            license.c_str()) == 0) 
+    // Mark the reservation as checked in under the record
+    // lock, in case another process moved it since the lookup
+    bool wasOnBoard = false;
+    bool marked = records.modifyAt(matchSlot, 
+        [&](Reservation &current)
+    {
+        if (strncmp(current.license, license.c_str(),
+                    LICENSE_LENGTH) != 0
+            || current.sailingKey != sailingKey)
         {
-            // Mark the reservation as checked in
-            reservation.onBoard = true; 
-            // Output fare for the vehicle
-            cout << "The fare for your vehicle is : $" 
-                << calculateFare(license) << endl; 
-
-            // Update the record in the file
-            // Move write pointer to the start of the current
-            // record
-            Util::reservationFile.seekp(recordStartPos); 
-            // Write updated reservation data
-            reservation.writeToFile(Util::reservationFile); 
-            return; // Exit after updating
+            return false;
         }
+        wasOnBoard = current.onBoard;
+        current.onBoard = true;
+        return true;
+    });
+    if (!marked)
+    {
+        cout << "Reservation with license " << license 
+            << " not found." << endl; 
+        return false; 
     }
 
-    // Error message if reservation not found
-    cout << "Reservation with license " << license 
-        << " not found." << endl; 
+    // Output fare for the vehicle
+    cout << "The fare for your vehicle is : $" 
+        << calculateFare(license) << endl; 
+    return !wasOnBoard;
 }
 
 //$14 for normal vehicles under 2m high and 7m long
@@ -443,12 +499,21 @@ void Reservation::setCheckedIn(const string &license)
 // long overheight vehicles $3 * length in meters
 float Reservation::calculateFare(const string &license)
 {
+    lock_guard<OwnedMutex> lock(Util::reservationLock);
     // Create a Vehicle instance to fetch details
     Vehicle vehicle; 
-    // Get height of the vehicle
-    float height = vehicle.getHeight(license); 
-    // Get length of the vehicle
-    float length = vehicle.getLength(license); 
+    // Fetch the whole vehicle record in one lookup
+    if (!Vehicle::find(license, vehicle)) 
+    {
+        // Unknown vehicle, no fare can be charged
+        return 0.0; 
+    }
+    // Get height of the vehicle in decimetres
+    int height = vehicle.height; 
+    // Get length of the vehicle in decimetres
+    int length = vehicle.length; 
+    // Fares are charged per metre
+    double metres = Util::toMetres(length); 
 
     if (height <= REGULAR_VEHICLE_HEIGHT 
         && length <= REGULAR_VEHICLE_LENGTH)
@@ -460,13 +525,13 @@ float Reservation::calculateFare(const string &license)
             && height <= REGULAR_VEHICLE_HEIGHT)
     { 
         // Long overheight vehicle fare
-        return 2.0 * length; 
+        return 2.0 * metres; 
     }
     else if (length > REGULAR_VEHICLE_LENGTH 
             && height > REGULAR_VEHICLE_HEIGHT)
     { 
         // Long-overheight special vehicle
-        return 3.0 * length; 
+        return 3.0 * metres; 
     }
     else if (length > REGULAR_VEHICLE_LENGTH 
             && height > REGULAR_VEHICLE_HEIGHT 
@@ -474,8 +539,205 @@ float Reservation::calculateFare(const string &license)
             && height <= REGULAR_VEHICLE_HEIGHT) 
     {
         // Combined fare for both conditions
-        return (3.0 * length) + (2.0 * length); 
+        return (3.0 * metres) + (2.0 * metres); 
     }
     // Return 0 for invalid vehicle dimensions
     return 0.0; 
+}
+
+//**********************************************************
+// openIndex()
+// Builds the sailing ID -> slots index with one scan of
+// reservation.dat.
+//**********************************************************
+void Reservation::openIndex()
+{
+    lock_guard<OwnedMutex> lock(Util::reservationLock);
+    if (stampFd < 0) 
+    {
+        stampFd = ::open("reservation.stamp", O_RDWR | O_CREAT,
+                        0644); 
+        stampLock.open("reservation.stamp"); 
+    }
+
+    // Read first, so a change made during the scan is seen
+    // by the next refreshIndex
+    indexStamp = readStamp(); 
+    index.clear(); 
+
+    // Index every complete record
+    records.scan([](const char *record, int slot) 
+    {
+        // Stored as license then sailing key
+        uint32_t recordKey; 
+        memcpy(&recordKey, record + LICENSE_LENGTH + 1, 
+                sizeof(recordKey)); 
+        index[recordKey].push_back(slot); 
+        return true; 
+    }); 
+}
+
+//**********************************************************
+// closeIndex()
+//**********************************************************
+void Reservation::closeIndex()
+{
+    lock_guard<OwnedMutex> lock(Util::reservationLock);
+    stampLock.close(); 
+    if (stampFd >= 0) 
+    {
+        ::close(stampFd); 
+        stampFd = -1; 
+    }
+}
+
+//**********************************************************
+// readStamp()
+//**********************************************************
+uint64_t Reservation::readStamp()
+{
+    uint64_t stamp = 0; 
+    if (stampFd >= 0) 
+    {
+        RangeLock shared(stampLock, 0, sizeof(stamp), false); 
+        if (pread(stampFd, &stamp, sizeof(stamp), 0) 
+                != static_cast<ssize_t>(sizeof(stamp))) 
+        {
+            stamp = 0; // Never changed
+        }
+    }
+    return stamp; 
+}
+
+//**********************************************************
+// noteChange()
+// A stamp that moved on by more than this change means
+// another process changed the file too, so the index is
+// left behind and rebuilt by the next refreshIndex.
+//**********************************************************
+void Reservation::noteChange()
+{
+    if (stampFd < 0) 
+    {
+        return; 
+    }
+
+    uint64_t stamp = 0; 
+    {
+        RangeLock whole(stampLock, 0, sizeof(stamp), true); 
+        if (pread(stampFd, &stamp, sizeof(stamp), 0) 
+                != static_cast<ssize_t>(sizeof(stamp))) 
+        {
+            stamp = 0; 
+        }
+        stamp++; 
+        if (pwrite(stampFd, &stamp, sizeof(stamp), 0) 
+                != static_cast<ssize_t>(sizeof(stamp))) 
+        {
+            return; 
+        }
+    }
+
+    if (stamp == indexStamp + 1) 
+    {
+        indexStamp = stamp; 
+    }
+}
+
+//**********************************************************
+// refreshIndex()
+//**********************************************************
+void Reservation::refreshIndex()
+{
+    if (readStamp() != indexStamp) 
+    {
+        openIndex(); 
+    }
+}
+
+//**********************************************************
+// readAt()
+// Reads the reservation stored in a given slot.
+//**********************************************************
+bool Reservation::readAt(int slot, Reservation &reservation)
+{
+    return records.readAt(slot, reservation); 
+}
+
+//**********************************************************
+// keyOf()
+// Encodes a sailing ID; 0 for an invalid one, which no
+// reservation is ever indexed under.
+//**********************************************************
+uint32_t Reservation::keyOf(const string &sailingId)
+{
+    uint32_t key = 0; 
+    Sailing::isValidSailingId(sailingId, key); 
+    return key; 
+}
+
+//**********************************************************
+// findSlot()
+// Checks only the records indexed under sailingId for a
+// matching license and sailing.
+//**********************************************************
+int Reservation::findSlot(const string &license, 
+                        uint32_t sailingKey)
+{
+    auto entry = index.find(sailingKey); 
+    if (entry == index.end()) 
+    {
+        return -1; // No reservations on this sailing
+    }
+
+    Reservation reservation; 
+    for (int slot : entry->second) 
+    {
+        if (readAt(slot, reservation) 
+            && reservation.sailingKey == sailingKey 
+            && strncmp(reservation.license, license.c_str(),
+                        LICENSE_LENGTH) == 0) 
+        {
+            return slot; 
+        }
+    }
+
+    return -1; 
+}
+
+//**********************************************************
+// moveSlot()
+// Updates a sailing's slot list after a record moves, or
+// drops the slot when newSlot is -1.
+//**********************************************************
+void Reservation::moveSlot(uint32_t sailingKey, 
+                        int oldSlot, int newSlot)
+{
+    auto entry = index.find(sailingKey); 
+    if (entry == index.end()) 
+    {
+        return; 
+    }
+
+    vector<int> &slots = entry->second; 
+    for (size_t i = 0; i < slots.size(); i++) 
+    {
+        if (slots[i] != oldSlot) continue; 
+
+        if (newSlot >= 0) 
+        {
+            slots[i] = newSlot; 
+        }
+        else
+        {
+            // Order does not matter, so swap with the back
+            slots[i] = slots.back(); 
+            slots.pop_back(); 
+            if (slots.empty()) 
+            {
+                index.erase(entry); 
+            }
+        }
+        return; 
+    }
 }
\ No newline at end of file
@@ -7,36 +7,50 @@
 // operations for managing ferry reservations in a fixed-
 // length format.
 // July 24, 2025 - ver. 3 - Created by all team members
+// Oct 17, 2026 - ver. 4 - Team 18, secondary index from
+// sailing ID to reservation slots
+// Oct 17, 2026 - ver. 5 - Team 18, sailings stored as their
+// 32-bit encoded key
+// Oct 17, 2026 - ver. 6 - Team 18, find, and check-in by
+// license and sailing
+// Oct 17, 2026 - ver. 7 - Team 18, index reloaded after
+// other processes change reservation.dat
 //*********************************************************
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <fstream>
+#include <vector>
+#include <unordered_map>
 #include "Sailing.h"
+#include "RecordFile.h"
 
 using namespace std;
 
+struct ReservationKey;
+
 class Reservation
 {
 public:
     //*********************************************************
     // Constants for binary fixed-length record layout
-    // Fixed sailing ID length and license length
+    // Fixed license length
     //*********************************************************
-    static const int SAILING_ID_LENGTH = 9;
     static const int LICENSE_LENGTH = 10;
     
-    // Total size of one binary reservation record 
-    // (+2 for null terminators)
+    // Total size of one binary reservation record: license
+    // (+1 for null terminator), encoded sailing ID, onBoard
     static const int RECORD_SIZE = LICENSE_LENGTH + 1 
-                    + SAILING_ID_LENGTH + 1 + sizeof(bool); 
+                    + Sailing::KEY_SIZE + sizeof(bool); 
     static const int REGULAR_VEHICLE_FARE = 14;
 
     //*********************************************************
     // Reservation record fields (stored in binary file)
     //*********************************************************
-    char sailingId[SAILING_ID_LENGTH + 1]; 
+    // Sailing ID encoded by Sailing::isValidSailingId
+    uint32_t sailingKey; 
     char license[LICENSE_LENGTH + 1]; 
 
     // true if the vehicle has boarded
@@ -61,6 +75,13 @@ public:
     // in-out: loads this reservation from binary stream
     bool readFromFile(fstream &file);      
 
+    // in: record - RECORD_SIZE bytes in file layout, e.g. a
+    // record handed out by RecordScanner
+    void readFromBuffer(const char *record);
+
+    // out: record - RECORD_SIZE bytes in file layout
+    void writeToBuffer(char *record) const;
+
     //*********************************************************
     // Query Total Reservations for a Given Sailing
     // in: sailingId
@@ -68,6 +89,14 @@ public:
     static int getTotalReservationsOnSailing(
                                     const string &sailingId);
 
+    //*********************************************************
+    // List All Reservations for a Given Sailing
+    // in: sailingId
+    // out: the reservation records on that sailing
+    //*********************************************************
+    static vector<Reservation> getReservationsOnSailing(
+                                    const string &sailingId);
+
     //*********************************************************
     // Remove Specific Reservation
     // in: sailingId, license
@@ -89,6 +118,14 @@ public:
     static bool checkExist(const string &license, 
                             const string &sailingId);               
 
+    //*********************************************************
+    // Read a Reservation Through the Index
+    // in: license, sailingId
+    // out: found, true if the reservation exists
+    //*********************************************************
+    static bool find(const string &license, 
+                    const string &sailingId, Reservation &found);
+
     //*********************************************************
     // Create a New Reservation
     // in: sailingId, license
@@ -99,8 +136,10 @@ public:
     //*********************************************************
     // Mark Reservation as Checked In
     //*********************************************************
-    // in: sailingId, license
-    static void setCheckedIn(const string &license); 
+    // in: license, sailingId
+    // out: true if the reservation was not checked in before
+    static bool setCheckedIn(const string &license,
+                            const string &sailingId); 
 
     // Calculates fare based on vehicle type and sailing
     static float calculateFare(const string &license); 
@@ -109,4 +148,100 @@ public:
     // out: returns formatted string version of reservation
     //*********************************************************
     string toString() const; 
-};
\ No newline at end of file
+
+    //*********************************************************
+    // Build the Sailing -> Reservations Index
+    //*********************************************************
+    // Scans reservation.dat once. Called by Util::startup.
+    static void openIndex();
+
+    //*********************************************************
+    // Close the Change Stamp
+    //*********************************************************
+    // Called by Util::shutdown.
+    static void closeIndex();
+
+private:
+    //*********************************************************
+    // Secondary index: sailing key -> slots in reservation.dat
+    //*********************************************************
+    static unordered_map<uint32_t, vector<int>> index;
+
+    //*********************************************************
+    // Change stamp: a counter in reservation.stamp that every
+    // process adds one to after it moves, adds or removes
+    // reservation records. The index is rebuilt whenever the
+    // stamp differs from the one it was built at, so changes
+    // made by other processes are seen.
+    //*********************************************************
+    static int stampFd;
+    static FileLock stampLock;
+    static uint64_t indexStamp;
+
+    //*********************************************************
+    // Read the Change Stamp
+    // out: its value, 0 if it was never changed
+    //*********************************************************
+    static uint64_t readStamp();
+
+    //*********************************************************
+    // Record a Change Made by This Process
+    //*********************************************************
+    // Adds one to the stamp; the index keeps up with it if no
+    // other process changed the file since it was built.
+    static void noteChange();
+
+    //*********************************************************
+    // Rebuild the Index if Another Process Changed the File
+    //*********************************************************
+    static void refreshIndex();
+
+    // reservation.dat records
+    static RecordFile<Reservation, ReservationKey> records;
+
+    //*********************************************************
+    // Read the Record Stored in a Slot
+    // in: slot
+    // out: reservation, true if the read succeeded
+    //*********************************************************
+    static bool readAt(int slot, Reservation &reservation);
+
+    //*********************************************************
+    // Encode a Sailing ID
+    // in: sailingId
+    // out: its key, or 0 (never indexed) if it is not valid
+    //*********************************************************
+    static uint32_t keyOf(const string &sailingId);
+
+    //*********************************************************
+    // Find the Slot of a Reservation Through the Index
+    // in: license, sailingKey
+    // out: slot, or -1 if not found
+    //*********************************************************
+    static int findSlot(const string &license, 
+                        uint32_t sailingKey);
+
+    //*********************************************************
+    // Replace One Slot With Another in a Sailing's List
+    // in: sailingKey, oldSlot, newSlot (-1 removes oldSlot)
+    //*********************************************************
+    static void moveSlot(uint32_t sailingKey, int oldSlot, 
+                        int newSlot);
+};
+
+//*********************************************************
+// ReservationKey
+//*********************************************************
+// Key of a reservation record for RecordFile: the license
+// and sailing key stored together at the start of the record.
+//*********************************************************
+struct ReservationKey : NoTombstones
+{
+    static const int LENGTH = Reservation::LICENSE_LENGTH + 1
+                            + Sailing::KEY_SIZE;
+
+    static void extract(const char *record, char *key)
+    {
+        memcpy(key, record, LENGTH);
+    }
+};
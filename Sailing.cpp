@@ -8,15 +8,36 @@
 // and removing
 // fixed-length binary records representing sailings.
 // July 21, 2025 Version 2 - Team 18
+// Oct 17, 2026 Version 3 - Team 18, lanes in whole decimetres
+// Oct 17, 2026 Version 4 - Team 18, 32-bit encoded sailing key
+// Oct 17, 2026 Version 5 - Team 18, tombstone deletes
+// Oct 17, 2026 Version 6 - Team 18, flushCapacity
+// Oct 17, 2026 Version 7 - Team 18, rebuildCapacity
+// Oct 17, 2026 Version 8 - Team 18, tallyReservations
+// Oct 17, 2026 Version 9 - Team 18, key ranges by terminal,
+// day and hour
+// Oct 17, 2026 Version 10 - Team 18, bookings take lane space
+// from the capacity table only
+// Oct 17, 2026 Version 11 - Team 18, bookings take lane space
+// under the record lock while other processes run
 //*********************************************************
 
 #include "Sailing.h"
 #include "Util.h"
 #include "Vehicle.h"
+#include "Vessel.h"
+#include "Reservation.h"
+#include "WriteAheadLog.h"
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <iostream>
 #include <iomanip>
+#include <cctype>
+#include <cstdio>
 #include <cstring>
-#include <vector>
 
 using namespace std;
 
@@ -28,8 +49,9 @@ Sailing::Sailing()
 {
     memset(sailingId, 0, sizeof(sailingId));
     memset(vesselName, 0, sizeof(vesselName));
-    HRL = 0.0;
-    LRL = 0.0;
+    key = 0;
+    HRL = 0;
+    LRL = 0;
 }
 
 //*********************************************************
@@ -40,11 +62,13 @@ Sailing::Sailing()
 //*********************************************************
 Sailing::Sailing(const char *sailingId, 
                 const char *vesselName, 
-                double HRL, double LRL)
+                int HRL, int LRL)
 {
     strncpy(this->sailingId, sailingId, 
             SAILING_ID_LENGTH);
     this->sailingId[SAILING_ID_LENGTH] = '\0';
+    key = 0;
+    isValidSailingId(this->sailingId, key);
 
     strncpy(this->vesselName, vesselName, 
             VESSEL_NAME_LENGTH);
@@ -62,10 +86,12 @@ Sailing::Sailing(const char *sailingId,
 //*********************************************************
 void Sailing::open(const string &id, 
                 const string &vName, 
-                double hrl, double lrl)
+                int hrl, int lrl)
 {
     strncpy(sailingId, id.c_str(), SAILING_ID_LENGTH);
     sailingId[SAILING_ID_LENGTH] = '\0';
+    key = 0;
+    isValidSailingId(sailingId, key);
 
     strncpy(vesselName, vName.c_str(), VESSEL_NAME_LENGTH);
     vesselName[VESSEL_NAME_LENGTH] = '\0';
@@ -83,13 +109,14 @@ void Sailing::writeToFile(fstream &file) const
 {
     if (file.is_open())
     {
-        // Write SailingId, vesselName, HRL and LRL
-        file.write(sailingId, SAILING_ID_LENGTH + 1);                  
+        // Write the sailing key, vesselName, HRL and LRL
+        file.write(reinterpret_cast<const char *>(&key), 
+                    KEY_SIZE);                  
         file.write(vesselName, VESSEL_NAME_LENGTH + 1);              
         file.write(reinterpret_cast<const char *>(&HRL),
-                    sizeof(double)); 
+                    sizeof(int)); 
         file.write(reinterpret_cast<const char *>(&LRL),
-                    sizeof(double)); 
+                    sizeof(int)); 
     }
     else
     {
@@ -107,13 +134,14 @@ void Sailing::readFromFile(fstream &file)
 {
     if (file.is_open())
     {
-        // Read sailingID, vesselName, HRL, LRL
-        file.read(sailingId, sizeof(sailingId));            
+        // Read the sailing key, vesselName, HRL, LRL
+        file.read(reinterpret_cast<char *>(&key), KEY_SIZE);            
         file.read(vesselName, sizeof(vesselName)); 
         file.read(reinterpret_cast<char *>(&HRL), 
-                    sizeof(double));
+                    sizeof(int));
         file.read(reinterpret_cast<char *>(&LRL), 
-                    sizeof(double));
+                    sizeof(int));
+        strcpy(sailingId, sailingIdFromKey(key).c_str());
     }
     else
     {
@@ -122,42 +150,369 @@ void Sailing::readFromFile(fstream &file)
 }
 
 //*********************************************************
-// searchForSailing()
-// Searches for a sailing record by ID
-// in: sailingId
-// out: fills foundSailing and returns true if match found
+// readFromBuffer()
+// Copies the fields out of a record in file layout
+// in: record - RECORD_SIZE bytes
 //*********************************************************
-bool Sailing::searchForSailing(const string &sailingId, 
-                                Sailing &foundSailing)
+void Sailing::readFromBuffer(const char *record)
+{
+    memcpy(&key, record, KEY_SIZE);
+    record += KEY_SIZE;
+    strcpy(sailingId, sailingIdFromKey(key).c_str());
+    memcpy(vesselName, record, sizeof(vesselName));
+    record += sizeof(vesselName);
+    memcpy(&HRL, record, sizeof(int));
+    record += sizeof(int);
+    memcpy(&LRL, record, sizeof(int));
+}
+
+//*********************************************************
+// writeToBuffer()
+// Copies the fields into a record in file layout
+// out: record - RECORD_SIZE bytes
+//*********************************************************
+void Sailing::writeToBuffer(char *record) const
+{
+    memcpy(record, &key, KEY_SIZE);
+    record += KEY_SIZE;
+    memcpy(record, vesselName, sizeof(vesselName));
+    record += sizeof(vesselName);
+    memcpy(record, &HRL, sizeof(int));
+    record += sizeof(int);
+    memcpy(record, &LRL, sizeof(int));
+}
+
+//*********************************************************
+// Index of sailing ID -> slot, backed by sailing.idx, and
+// the sailing.dat records it points into
+//*********************************************************
+HashIndex Sailing::index("sailing.idx", SailingKey::LENGTH);
+RecordFile<Sailing, SailingKey> Sailing::records(
+                        Util::sailingFile, Util::sailingFileLock,
+                        "sailing.dat", &index);
+CapacityTable Sailing::capacity;
+
+//*********************************************************
+// findRecord()
+// Finds a sailing through the index and reads the record
+// at its slot with a single read
+// out: fills foundSailing, returns its slot or -1
+//*********************************************************
+int Sailing::findRecord(uint32_t key, Sailing &foundSailing)
 {
-    Util::sailingFile.clear();
-    Util::sailingFile.seekg(0, ios::beg);
+    char keyBytes[SailingKey::LENGTH];
+    memcpy(keyBytes, &key, KEY_SIZE);
+    int slot = records.find(keyBytes, foundSailing);
 
+    // The table is ahead of the record until write-back
+    if (slot >= 0)
+    {
+        capacity.get(key, foundSailing.HRL, foundSailing.LRL);
+    }
+    return slot;
+}
+
+//*********************************************************
+// findRecord() by ID
+//*********************************************************
+int Sailing::findRecord(const string &sailingId, 
+                        Sailing &foundSailing)
+{
+    uint32_t key;
+    if (!isValidSailingId(sailingId, key))
+    {
+        return -1;
+    }
+    return findRecord(key, foundSailing);
+}
+
+//*********************************************************
+// keyOrZero()
+// An invalid ID keeps key 0, which is never in the capacity
+// table, so lookups with it fail like any unknown sailing
+//*********************************************************
+uint32_t Sailing::keyOrZero(const string &sailingId)
+{
+    uint32_t key = 0;
+    isValidSailingId(sailingId, key);
+    return key;
+}
+
+//*********************************************************
+// openIndex()
+// Opens sailing.idx and rebuilds it when its entry count
+// does not match the number of records in sailing.dat
+//*********************************************************
+void Sailing::openIndex()
+{
+    lock_guard<OwnedMutex> lock(Util::sailingLock);
+    records.openIndex();
+
+    // Load every sailing's lanes into the capacity table
+    capacity.clear();
     Sailing sailing;
+    records.scan([&](const char *record, int slot)
+    {
+        sailing.readFromBuffer(record);
+        capacity.set(sailing.key, sailing.HRL, sailing.LRL);
+        return true;
+    });
+
+    capacity.startFlusher(persistCapacity);
+}
+
+//*********************************************************
+// closeIndex()
+//*********************************************************
+void Sailing::closeIndex()
+{
+    // The flusher takes the sailing lock, so it is stopped
+    // before the lock is held here
+    capacity.stopFlusher();
+
+    lock_guard<OwnedMutex> lock(Util::sailingLock);
+    records.closeIndex();
+}
+
+//*********************************************************
+// flushCapacity()
+//*********************************************************
+void Sailing::flushCapacity()
+{
+    capacity.flushNow();
+}
+
+//*********************************************************
+// reloadCapacity()
+// The slots are collected first, since the scan holds the
+// locks modifyAt would take
+//*********************************************************
+void Sailing::reloadCapacity()
+{
+    lock_guard<OwnedMutex> lock(Util::sailingLock);
+
+    vector<pair<int, uint32_t>> sailings;
+    records.scan([&](const char *record, int slot)
+    {
+        uint32_t key;
+        memcpy(&key, record, KEY_SIZE);
+        sailings.push_back(make_pair(slot, key));
+        return true;
+    });
+
+    for (auto &sailing : sailings)
+    {
+        records.modifyAt(sailing.first, [&](Sailing &current)
+        {
+            int high, low;
+            if (current.key != sailing.second)
+            {
+                return false; // Moved by a compaction
+            }
+            if (!capacity.get(current.key, high, low))
+            {
+                capacity.set(current.key, current.HRL,
+                            current.LRL);
+                return false;
+            }
+            return syncLanes(current);
+        });
+    }
+}
+
+//*********************************************************
+// tallyReservations()
+// Reads vehicle.dat, then reservation.dat, each split into
+// one range per worker with a partial result per worker,
+// merged once the pass is done
+//*********************************************************
+unordered_map<uint32_t, Sailing::Tally> Sailing::tallyReservations(
+                                                    int workers)
+{
+    workers = max(workers, 1);
+    lock_guard<OwnedMutex> reservationLock(
+                                    Util::reservationLock);
+    lock_guard<OwnedMutex> vehicleLock(Util::vehicleLock);
+
+    // Step 1: license -> height and length of every vehicle
+    RecordFile<Vehicle, VehicleKey> vehicleRecords(
+                    Util::vehicleFile, Util::vehicleFileLock,
+                    "vehicle.dat");
+    vector<unordered_map<string, pair<int, int>>> sizeParts(
+                                                    workers);
+    vehicleRecords.parallelScan(workers,
+        [&](const char *record, int, int worker)
+    {
+        Vehicle vehicle;
+        vehicle.readFromBuffer(record);
+        sizeParts[worker][vehicle.license] = 
+                        make_pair(vehicle.height, vehicle.length);
+    });
+
+    unordered_map<string, pair<int, int>> sizes;
+    for (auto &part : sizeParts)
+    {
+        sizes.insert(part.begin(), part.end());
+        part.clear();
+    }
+
+    // Step 2: sailing key -> what its reservations add up to
+    RecordFile<Reservation, ReservationKey> reservationRecords(
+            Util::reservationFile, Util::reservationFileLock,
+            "reservation.dat");
+    vector<unordered_map<uint32_t, Tally>> tallyParts(workers);
+    reservationRecords.parallelScan(workers,
+        [&](const char *record, int, int worker)
+    {
+        Reservation reservation;
+        reservation.readFromBuffer(record);
+        Tally &tally = tallyParts[worker][reservation.sailingKey];
+        tally.vehicles++;
+        tally.checkedIn += reservation.onBoard ? 1 : 0;
+
+        auto size = sizes.find(reservation.license);
+        if (size == sizes.end())
+        {
+            return; // Unknown vehicle, no lane to charge
+        }
+
+        int length = size->second.second + VEHICLE_GAP;
+        if (size->second.first > REGULAR_VEHICLE_HEIGHT)
+        {
+            tally.usedHigh += length;
+        }
+        else
+        {
+            tally.usedLow += length;
+        }
+    });
 
-    while (true)
+    unordered_map<uint32_t, Tally> tallies;
+    for (auto &part : tallyParts)
     {
-        if (!Util::sailingFile.read(sailing.sailingId, 
-                        SAILING_ID_LENGTH + 1)) break;
+        for (auto &sailing : part)
+        {
+            Tally &total = tallies[sailing.first];
+            total.usedHigh += sailing.second.usedHigh;
+            total.usedLow += sailing.second.usedLow;
+            total.vehicles += sailing.second.vehicles;
+            total.checkedIn += sailing.second.checkedIn;
+        }
+        part.clear();
+    }
+    return tallies;
+}
 
-        if (!Util::sailingFile.read(sailing.vesselName, 
-                        VESSEL_NAME_LENGTH + 1)) break;
+//*********************************************************
+// rebuildCapacity()
+// Vehicles are loaded into a map first, then each worker
+// sums the lanes taken on its range of reservation.dat into
+// its own map, so the workers share nothing they write. A
+// reservation takes its vehicle's length plus VEHICLE_GAP
+// from the high lane if the vehicle is over
+// REGULAR_VEHICLE_HEIGHT, otherwise from the low lane, as
+// in OtherControls.
+//*********************************************************
+int Sailing::rebuildCapacity()
+{
+    // Every file is read, so every lock is held, in order
+    lock_guard<OwnedMutex> vesselLock(Util::vesselLock);
+    lock_guard<OwnedMutex> sailingLock(Util::sailingLock);
+    lock_guard<OwnedMutex> reservationLock(
+                                    Util::reservationLock);
+    lock_guard<OwnedMutex> vehicleLock(Util::vehicleLock);
+
+    // Step 1: lane taken on every sailing
+    int workers = max(1u, thread::hardware_concurrency());
+    unordered_map<uint32_t, Tally> taken = 
+                                    tallyReservations(workers);
+
+    // Step 2: find the sailings whose lanes disagree. They
+    // are written after the scan, which uses the same stream
+    vector<pair<int, Sailing>> corrected;
+    records.scan([&](const char *record, int slot)
+    {
+        Sailing sailing;
+        sailing.readFromBuffer(record);
+        int hcll = Vessel::getHCLL(sailing.vesselName);
+        int lcll = Vessel::getLCLL(sailing.vesselName);
+        if (hcll < 0 || lcll < 0)
+        {
+            return true; // Vessel unknown; leave it as is
+        }
 
-        if (!Util::sailingFile.read(reinterpret_cast
-        <char *>(&sailing.HRL), sizeof(double))) break;
-        
-        if (!Util::sailingFile.read(reinterpret_cast
-        <char *>(&sailing.LRL), sizeof(double))) break;
+        const Tally &used = taken[sailing.key];
+        int high = hcll * Util::DECIMETRES_PER_METRE 
+                    - used.usedHigh;
+        int low = lcll * Util::DECIMETRES_PER_METRE - used.usedLow;
+        int currentHigh = sailing.HRL;
+        int currentLow = sailing.LRL;
+        capacity.get(sailing.key, currentHigh, currentLow);
 
-        if (strcmp(sailing.sailingId, 
-            sailingId.c_str()) == 0)
+        if (high != sailing.HRL || low != sailing.LRL
+            || high != currentHigh || low != currentLow)
         {
-            foundSailing = sailing;
-            return true;
+            sailing.HRL = high;
+            sailing.LRL = low;
+            corrected.push_back(make_pair(slot, sailing));
         }
+        return true;
+    });
+
+    for (auto &sailing : corrected)
+    {
+        records.updateAt(sailing.first, sailing.second);
+        capacity.set(sailing.second.key, sailing.second.HRL,
+                    sailing.second.LRL);
     }
 
-    return false;
+    return static_cast<int>(corrected.size());
+}
+
+//*********************************************************
+// persistCapacity()
+// Merges a sailing's lanes in the capacity table with its
+// record in sailing.dat, with the record locked so changes
+// made by other processes are kept
+//*********************************************************
+void Sailing::persistCapacity(uint32_t key)
+{
+    lock_guard<OwnedMutex> lock(Util::sailingLock);
+
+    Sailing sailing;
+    int slot = findRecord(key, sailing);
+    if (slot >= 0)
+    {
+        records.modifyAt(slot, [&](Sailing &current)
+        {
+            return syncLanes(current);
+        });
+    }
+}
+
+//*********************************************************
+// syncLanes()
+// Folds the record's lanes into the capacity table and the
+// table's back into the record
+// in-out: sailing - the record as read from disk
+// out: false if the sailing is not in the table
+//*********************************************************
+bool Sailing::syncLanes(Sailing &sailing)
+{
+    return capacity.sync(sailing.key, sailing.HRL, sailing.LRL);
+}
+
+//*********************************************************
+// searchForSailing()
+// Searches for a sailing record by ID
+// in: sailingId
+// out: fills foundSailing and returns true if match found
+//*********************************************************
+bool Sailing::searchForSailing(const string &sailingId, 
+                                Sailing &foundSailing)
+{
+    lock_guard<OwnedMutex> lock(Util::sailingLock);
+    return findRecord(sailingId, foundSailing) >= 0;
 }
 
 //*********************************************************
@@ -166,73 +521,34 @@ bool Sailing::searchForSailing(const string &sailingId,
 //*********************************************************
 Sailing Sailing::getSailingInfo(const string &sailingId)
 {
+    lock_guard<OwnedMutex> lock(Util::sailingLock);
     if (!Util::sailingFile.is_open())
     {
-        Util::sailingFile.open("sailing.dat", ios::in 
-                                            | ios::binary);
-        if (!Util::sailingFile.is_open()) {
-            cout << "Could not open sailing.dat\n";
-            return Sailing();
-        }
+        cout << "Could not open sailing.dat\n";
+        return Sailing();
     }
 
-    Util::sailingFile.clear();
-    Util::sailingFile.seekg(0, ios::beg);
-
     Sailing sailing;
 
-    while (true)
+    if (findRecord(sailingId, sailing) < 0)
     {
-        if (!Util::sailingFile.read(sailing.sailingId, 
-                        SAILING_ID_LENGTH + 1)) break;
-        if (!Util::sailingFile.read(sailing.vesselName, 
-                        VESSEL_NAME_LENGTH + 1)) break;
-        if (!Util::sailingFile.read(reinterpret_cast
-        <char*>(&sailing.HRL), sizeof(double))) break;
-        
-        if (!Util::sailingFile.read(reinterpret_cast
-        <char*>(&sailing.LRL), sizeof(double))) break;
-
-        if (strcmp(sailing.sailingId, 
-                sailingId.c_str()) == 0)
-        {
-            return sailing;
-        }
+        return Sailing(); // Not found
     }
 
-    return Sailing(); // Not found
+    return sailing;
 }
 
+//*********************************************************
+// checkExist()
+// Returns true if a sailing with the given ID is indexed
+//*********************************************************
 bool Sailing::checkExist(string sailingId)
 {
+    lock_guard<OwnedMutex> lock(Util::sailingLock);
     if (Util::sailingFile.is_open())
     {
-        Util::sailingFile.clear();
-        Util::sailingFile.seekg(0, ios::beg);
-
         Sailing sailing;
-
-        while (true)
-        {
-            // Read each field safely
-            if (!Util::sailingFile.read(sailing.sailingId, 
-                            SAILING_ID_LENGTH + 1)) break;
-            if (!Util::sailingFile.read(sailing.vesselName, 
-                            VESSEL_NAME_LENGTH + 1)) break;
-            if (!Util::sailingFile.read(reinterpret_cast
-            <char*>(&sailing.HRL), sizeof(double))) break;
-            
-            if (!Util::sailingFile.read(reinterpret_cast
-            <char*>(&sailing.LRL), sizeof(double))) break;
-
-            if (strcmp(sailing.sailingId, 
-                        sailingId.c_str()) == 0)
-            {
-                return true;
-            }
-        }
-
-        return false;
+        return findRecord(sailingId, sailing) >= 0;
     }
     else
     {
@@ -243,75 +559,64 @@ bool Sailing::checkExist(string sailingId)
 
 //*********************************************************
 // writeSailing()
-// Appends a new sailing record to the sailing.dat file
+// Appends a new sailing record to the sailing.dat file and
+// indexes its slot
 //*********************************************************
 bool Sailing::writeSailing(std::string &sailingId, 
                             std::string &vesselName, 
-                            double HRL, double LRL)
+                            int HRL, int LRL)
 {
+    lock_guard<OwnedMutex> lock(Util::sailingLock);
     const char *sId = sailingId.c_str();
     const char *vName = vesselName.c_str();
     Sailing sailing(sId, vName, HRL, LRL);
-    Util::sailingFile.clear();
-    Util::sailingFile.seekg(0, ios::end);
-    sailing.writeToFile(Util::sailingFile);
-    Util::sailingFile.flush(); // Save to disk
+    if (records.append(sailing) < 0)
+    {
+        return false;
+    }
+
+    capacity.set(sailing.key, HRL, LRL);
     return true;
 }
 
 //*********************************************************
 // removeSailing()
-// Removes a sailing record by copying all non-matching
-// records
-// to a temp file and replacing the original
+// Overwrites the record with a tombstone, so no other
+// record moves; the tombstones are reclaimed in one pass
+// once enough have built up
 //*********************************************************
 bool Sailing::removeSailing(string sailingId)
 {
-    Util::sailingFile.clear();
-    Util::sailingFile.seekg(0, ios::beg);
-
-    vector<Sailing> sailings;
-    Sailing temp;
-    bool removed = false;
+    lock_guard<OwnedMutex> lock(Util::sailingLock);
+    Sailing sailing;
+    int slot = findRecord(sailingId, sailing);
 
-    // Step 1: Read all records using readFromFile
-    while (!Util::sailingFile.eof())
+    if (slot < 0)
     {
-        temp.readFromFile(Util::sailingFile);
-
-        if (Util::sailingFile.eof()) break;
-
-        if (strcmp(temp.sailingId, sailingId.c_str()) != 0)
-        {
-            sailings.push_back(temp);
-        }
-        else
-        {
-            removed = true;
-        }
+        return false;
     }
 
-    // Step 2: Truncate file
-    Util::sailingFile.close();
-    Util::sailingFile.open("sailing.dat", ios::out 
-                                        | ios::binary 
-                                        | ios::trunc);
+    capacity.remove(sailing.key);
+    records.eraseInPlace(slot);
 
-    // Step 3: Write back valid records using writeToFile
-    for (const auto &s : sailings)
+    int dead = records.deadCount();
+    if (dead >= COMPACT_MIN_DEAD && dead * 4 >= records.count())
     {
-        s.writeToFile(Util::sailingFile);
+        compactRecords();
     }
+    return true;
+}
 
-    Util::sailingFile.flush();
-    Util::sailingFile.close();
-
-    // Step 4: Reopen the file in read/write mode
-    Util::sailingFile.open("sailing.dat", ios::in 
-                                        | ios::out 
-                                        | ios::binary);
-
-    return removed;
+//*********************************************************
+// compactRecords()
+//*********************************************************
+int Sailing::compactRecords()
+{
+    lock_guard<OwnedMutex> lock(Util::sailingLock);
+    return records.compact([](const char *, int)
+    {
+        return true;
+    });
 }
 
 //*********************************************************
@@ -321,43 +626,23 @@ bool Sailing::removeSailing(string sailingId)
 //*********************************************************
 bool Sailing::isSpaceAvailable(const string &sailingId, 
                                 bool isSpecial, 
-                                float vehicleLength, 
-                                float vehicleHeight)
+                                int vehicleLength, 
+                                int vehicleHeight)
 {
-    if (!Util::sailingFile.is_open())
+    int high, low;
+    uint32_t key = keyOrZero(sailingId);
+
+    if (!capacity.get(key, high, low))
     {
-        cout << "sailing.dat not open." << endl;
         return false;
     }
 
-    Util::sailingFile.clear();
-    Util::sailingFile.seekg(0, ios::beg);
-
-    Sailing sailing;
+    cout << "Checking space on: " 
+        << sailingId << " HRL: " 
+        << Util::toMetres(high) << " LRL: " 
+        << Util::toMetres(low) << endl;
 
-    while (!Util::sailingFile.eof())
-    {
-        sailing.readFromFile(Util::sailingFile);
-
-        if (strcmp(sailing.sailingId, sailingId.c_str()) == 0)
-        {
-            cout << "Checking space on: " 
-                << sailing.sailingId << " HRL: " 
-                << sailing.HRL << " LRL: " 
-                << sailing.LRL << endl;
-
-            if (isSpecial)
-            {
-                return sailing.HRL >= vehicleLength;
-            }
-            else
-            {
-                return sailing.LRL >= vehicleLength;
-            }
-        }
-    }
-
-    return false;
+    return (isSpecial ? high : low) >= vehicleLength;
 }
 
 //*********************************************************
@@ -365,51 +650,98 @@ bool Sailing::isSpaceAvailable(const string &sailingId,
 // Deducts reserved vehicle length from LCLL or HRL
 //*********************************************************
 void Sailing::reduceSpace(const string &sailingId, 
-                            float vehicleLength, 
+                            int vehicleLength, 
                             bool isSpecial)
 {
-    if (!Util::sailingFile.is_open())
+    int high, low;
+    uint32_t key = keyOrZero(sailingId);
+
+    if (!capacity.add(key, isSpecial, 
+                    -(vehicleLength + VEHICLE_GAP), high, low))
     {
-        cout << "sailing.dat not open for reducing space." 
-                << endl;
-        return;
+        cout << "Sailing ID " << sailingId 
+                << " not found in reduceSpace()." << endl;
     }
+}
 
-    Util::sailingFile.clear();
-    Util::sailingFile.seekg(0, ios::beg);
+//*********************************************************
+// takeOnRecord()
+// The first sync brings in what other processes booked;
+// the second, after the deduction, returns the lanes to
+// write, so the record is never left without it
+//*********************************************************
+bool Sailing::takeOnRecord(uint32_t key, bool highLane,
+                            int needed, int amount,
+                            int &high, int &low)
+{
+    lock_guard<OwnedMutex> lock(Util::sailingLock);
 
     Sailing sailing;
-    streampos pos;
-
-    while (true)
+    int slot = findRecord(key, sailing);
+    if (slot < 0)
     {
-        pos = Util::sailingFile.tellg();
-
-        // Try reading record using your structured format
-        sailing.readFromFile(Util::sailingFile);
-
-        // If read failed, exit loop
-        if (Util::sailingFile.eof()) break;
+        return false;
+    }
 
-        if (strcmp(sailing.sailingId, 
-                            sailingId.c_str()) == 0)
+    bool reserved = false;
+    records.modifyAt(slot, [&](Sailing &current)
+    {
+        if (current.key != key)
+        {
+            return false; // Moved by a compaction
+        }
+        if (!capacity.get(key, high, low))
         {
-            if (isSpecial)
-                sailing.HRL -= (vehicleLength + 0.5);
-            else
-                sailing.LRL -= (vehicleLength + 0.5);
+            // Created by another process
+            capacity.set(key, current.HRL, current.LRL);
+        }
 
-            Util::sailingFile.clear();
-            Util::sailingFile.seekp(pos);
-            sailing.writeToFile(Util::sailingFile);
-            Util::sailingFile.flush();
+        syncLanes(current);
+        reserved = capacity.tryTake(key, highLane, needed,
+                                    amount, high, low);
+        return syncLanes(current);
+    });
+    return reserved;
+}
 
-            return;
-        }
+//*********************************************************
+// tryReserveSpace()
+// Alone, the check and the deduction are one
+// compare-and-swap on the capacity table, so there is no
+// window between them and no lock is taken; the flusher
+// writes the deduction back. Otherwise the record lock
+// keeps the other processes' bookings out meanwhile.
+//*********************************************************
+bool Sailing::tryReserveSpace(const string &sailingId,
+                                int vehicleLength,
+                                bool isSpecial,
+                                int &remainingHRL,
+                                int &remainingLRL)
+{
+    int high, low;
+    uint32_t key = keyOrZero(sailingId);
+
+    // Same rule as isSpaceAvailable()
+    bool reserved;
+    if (WriteAheadLog::isOnlyProcess())
+    {
+        reserved = capacity.tryTake(key, isSpecial,
+                    vehicleLength, vehicleLength + VEHICLE_GAP,
+                    high, low);
+    }
+    else
+    {
+        reserved = takeOnRecord(key, isSpecial, vehicleLength,
+                                vehicleLength + VEHICLE_GAP,
+                                high, low);
     }
 
-    cout << "Sailing ID " << sailingId 
-            << " not found in reduceSpace()." << endl;
+    if (reserved || capacity.get(key, high, low))
+    {
+        remainingHRL = high;
+        remainingLRL = low;
+    }
+    return reserved;
 }
 
 //*********************************************************
@@ -417,56 +749,27 @@ void Sailing::reduceSpace(const string &sailingId,
 //*********************************************************
 // Adds back vehicle length (used when canceling
 // reservation)
-// in-out: modifies sailing.dat
+// in-out: modifies the capacity table
 //*********************************************************
 void Sailing::addSpace(const string &sailingId, 
-                        float vehicleLength, bool isSpecial)
+                        int vehicleLength, bool isSpecial)
 {
-    if (!Util::sailingFile.is_open())
-    {
-        cout << "Error: sailing.dat is not open." << endl;
-        return;
-    }
-
-    Util::sailingFile.clear();
-    Util::sailingFile.seekg(0, ios::beg);
-
-    Sailing sailing;
-    streampos pos;
+    int high, low;
+    uint32_t key = keyOrZero(sailingId);
 
-    while (true)
+    // Add back to appropriate lane
+    if (!capacity.add(key, isSpecial,
+                    vehicleLength + VEHICLE_GAP, high, low))
     {
-        pos = Util::sailingFile.tellg();
-
-        sailing.readFromFile(Util::sailingFile);
-
-        if (Util::sailingFile.eof()) break;
-
-        if (strcmp(sailing.sailingId, 
-                                sailingId.c_str()) == 0)
-        {
-            // Add back to appropriate lane
-            if (isSpecial)
-                sailing.HRL += (vehicleLength + 0.5);
-            else
-                sailing.LRL += (vehicleLength + 0.5);
-
-            // Overwrite the current record
-            Util::sailingFile.clear();
-            Util::sailingFile.seekp(pos);
-            sailing.writeToFile(Util::sailingFile);
-            Util::sailingFile.flush();
-
-            cout << "Space restored in " 
-                    << (isSpecial ? "HRL" : "LRL")
-                    << ". Updated: HRL=" << sailing.HRL 
-                    << ", LRL=" << sailing.LRL << endl;
-            return;
-        }
+        cout << "Sailing ID " << sailingId 
+                << " not found in addSpace()." << endl;
+        return;
     }
 
-    cout << "Sailing ID " << sailingId 
-            << " not found in addSpace()." << endl;
+    cout << "Space restored in " 
+            << (isSpecial ? "HRL" : "LRL")
+            << ". Updated: HRL=" << Util::toMetres(high) 
+            << ", LRL=" << Util::toMetres(low) << endl;
 }
 
 //************************************************************
@@ -478,6 +781,21 @@ void Sailing::addSpace(const string &sailingId,
 // out: true if valid, false otherwise
 //************************************************************
 bool Sailing::isValidSailingId(const string &sailingId)
+{
+    uint32_t key;
+    return isValidSailingId(sailingId, key);
+}
+
+//************************************************************
+// isValidSailingId() with key
+//************************************************************
+// Letters are coded 1-26 (a-z) and 27-52 (A-Z), so the same
+// terminal in another case is another sailing, as before.
+// in: sailingId
+// out: key - set when valid; true if valid
+//************************************************************
+bool Sailing::isValidSailingId(const string &sailingId,
+                                uint32_t &key)
 {
     if (sailingId.length() != 9 
         || sailingId[3] != '-' 
@@ -485,91 +803,118 @@ bool Sailing::isValidSailingId(const string &sailingId)
         return false;
 
     // Check first 3 characters are letters
-    for (int i = 0; i < 3; ++i)
+    uint32_t code;
+    if (!encodeTerminal(sailingId.substr(0, 3), code))
+        return false;
+
+    // Check day and hour are two digits each
+    for (int i : {4, 5, 7, 8})
     {
-        if (!isalpha(sailingId[i]))
+        if (!isdigit(static_cast<unsigned char>(sailingId[i])))
             return false;
     }
 
-    // Extract and validate day and hour
-    string dayStr = sailingId.substr(4, 2);
-    string hourStr = sailingId.substr(7, 2);
-
-    int day = stoi(dayStr);
-    int hour = stoi(hourStr);
+    int day = (sailingId[4] - '0') * 10 + (sailingId[5] - '0');
+    int hour = (sailingId[7] - '0') * 10 + (sailingId[8] - '0');
 
     if (day < 1 || day > 31 || hour < 0 || hour > 23)
         return false;
 
+    key = keyFor(code, day, hour);
     return true;
 }
 
-double Sailing::getHRL(const string &sailingId) const
+//************************************************************
+// encodeTerminal()
+//************************************************************
+bool Sailing::encodeTerminal(const string &terminal, 
+                            uint32_t &code)
 {
-    if (!Util::sailingFile.is_open())
+    if (terminal.length() != 3)
+        return false;
+
+    code = 0;
+    for (char letter : terminal)
     {
-        cout << "Error: sailing.dat is not open." << endl;
-        return -1;
+        if (letter >= 'a' && letter <= 'z')
+            code = (code << LETTER_BITS) | (letter - 'a' + 1);
+        else if (letter >= 'A' && letter <= 'Z')
+            code = (code << LETTER_BITS) | (letter - 'A' + 27);
+        else
+            return false;
     }
+    return true;
+}
 
-    Util::sailingFile.clear();
-    Util::sailingFile.seekg(0, ios::beg);
+//************************************************************
+// keyFor()
+//************************************************************
+uint32_t Sailing::keyFor(uint32_t terminal, int day, int hour)
+{
+    uint32_t code = (terminal << DAY_BITS) | day;
+    return (code << HOUR_BITS) | hour;
+}
 
-    Sailing sailing;
+//************************************************************
+// terminalOfKey()
+//************************************************************
+uint32_t Sailing::terminalOfKey(uint32_t key)
+{
+    return key >> (DAY_BITS + HOUR_BITS);
+}
 
-    while (true)
+//************************************************************
+// sailingIdFromKey()
+//************************************************************
+string Sailing::sailingIdFromKey(uint32_t key)
+{
+    if (key == 0)
     {
-        if (!Util::sailingFile.read(sailing.sailingId, 
-                        SAILING_ID_LENGTH + 1)) break;
-        if (!Util::sailingFile.read(sailing.vesselName, 
-                        VESSEL_NAME_LENGTH + 1)) break;
-        if (!Util::sailingFile.read(reinterpret_cast
-        <char *>(&sailing.HRL), sizeof(double))) break;
+        return "";
+    }
 
-        if (!Util::sailingFile.read(reinterpret_cast
-        <char *>(&sailing.LRL), sizeof(double))) break;
+    int hour = key & ((1 << HOUR_BITS) - 1);
+    key >>= HOUR_BITS;
+    int day = key & ((1 << DAY_BITS) - 1);
+    key >>= DAY_BITS;
 
-        if (strcmp(sailing.sailingId, 
-                    sailingId.c_str()) == 0)
-        {
-            return sailing.HRL;
-        }
+    char letters[3];
+    for (int i = 2; i >= 0; --i)
+    {
+        int letter = key & ((1 << LETTER_BITS) - 1);
+        key >>= LETTER_BITS;
+        letters[i] = letter <= 26 ? 'a' + letter - 1 
+                                  : 'A' + letter - 27;
     }
 
-    return -1;
+    char sailingId[SAILING_ID_LENGTH + 1];
+    snprintf(sailingId, sizeof(sailingId), "%c%c%c-%02d-%02d",
+             letters[0], letters[1], letters[2], day, hour);
+    return sailingId;
 }
 
-double Sailing::getLRL(const string &sailingId) const
+int Sailing::getHRL(const string &sailingId) const
 {
-    if (!Util::sailingFile.is_open())
+    int high, low;
+    uint32_t key = keyOrZero(sailingId);
+
+    if (!capacity.get(key, high, low))
     {
-        cout << "Error: sailing.dat is not open." << endl;
         return -1;
     }
 
-    Util::sailingFile.clear();
-    Util::sailingFile.seekg(0, ios::beg);
+    return high;
+}
 
-    Sailing sailing;
+int Sailing::getLRL(const string &sailingId) const
+{
+    int high, low;
+    uint32_t key = keyOrZero(sailingId);
 
-    while (true)
+    if (!capacity.get(key, high, low))
     {
-        if (!Util::sailingFile.read(sailing.sailingId, 
-                        SAILING_ID_LENGTH + 1)) break;
-        if (!Util::sailingFile.read(sailing.vesselName, 
-                        VESSEL_NAME_LENGTH + 1)) break;
-        if (!Util::sailingFile.read(reinterpret_cast
-        <char *>(&sailing.HRL), sizeof(double))) break;
-
-        if (!Util::sailingFile.read(reinterpret_cast
-        <char *>(&sailing.LRL), sizeof(double))) break;
-
-        if (strcmp(sailing.sailingId, 
-                    sailingId.c_str()) == 0)
-        {
-            return sailing.LRL;
-        }
+        return -1;
     }
 
-    return -1;
-}
\ No newline at end of file
+    return low;
+}
@@ -7,15 +7,32 @@
 // Supports lane management (HRL, LRL), file I/O, and lookup
 // operations.
 // July 23, 2025 Version 3 - Team 18
+// Oct 17, 2026 Version 4 - Team 18, lookups go through a
+// persistent hash index (sailing.idx)
+// Oct 17, 2026 Version 5 - Team 18, lanes in whole decimetres
+// Oct 17, 2026 Version 6 - Team 18, 32-bit encoded sailing key
+// Oct 17, 2026 Version 7 - Team 18, tombstone deletes
+// Oct 17, 2026 Version 8 - Team 18, flushCapacity
+// Oct 17, 2026 Version 9 - Team 18, rebuildCapacity
+// Oct 17, 2026 Version 10 - Team 18, tallyReservations
+// Oct 17, 2026 Version 11 - Team 18, key ranges by terminal,
+// day and hour
 //*********************************************************
 
 #pragma once
 
+#include "HashIndex.h"
+#include "RecordFile.h"
+#include "CapacityTable.h"
+#include <cstdint>
 #include <fstream>
 #include <string>
+#include <unordered_map>
 
 using namespace std;
 
+struct SailingKey;
+
 class Sailing
 {
 public:
@@ -23,18 +40,44 @@ public:
     static const int SAILING_ID_LENGTH = 10;   
     // Length of vessel name (24 chars + null terminator)
     static const int VESSEL_NAME_LENGTH = 25; 
-    // Total size of binary record: ID, vesselName, HRL, 
-    // LRL (plus padding if any)
-    static const int RECORD_SIZE = SAILING_ID_LENGTH 
-                + VESSEL_NAME_LENGTH + sizeof(double) * 2;
+    // Size of an encoded sailing ID (see isValidSailingId)
+    static const int KEY_SIZE = sizeof(uint32_t);
+    // Total size of binary record: encoded ID, vesselName
+    // (with its null terminator), HRL, LRL
+    static const int RECORD_SIZE = KEY_SIZE
+                + VESSEL_NAME_LENGTH + 1 + sizeof(int) * 2;
+    // Space left behind each booked vehicle, in decimetres
+    static const int VEHICLE_GAP = 5;
+    // removeSailing compacts sailing.dat once it holds at
+    // least this many tombstones and they are a quarter of
+    // its records
+    static const int COMPACT_MIN_DEAD = 64;
+
+    //*********************************************************
+    // Tally
+    //*********************************************************
+    // What the reservations on one sailing add up to, as
+    // counted by tallyReservations. Lengths in decimetres,
+    // gaps included.
+    //*********************************************************
+    struct Tally
+    {
+        int usedHigh = 0;
+        int usedLow = 0;
+        int vehicles = 0;
+        int checkedIn = 0;
+    };
 
     // +1 for null terminator
     char sailingId[SAILING_ID_LENGTH + 1];   
+    // sailingId encoded, as stored in sailing.dat; 0 if the
+    // ID is not valid
+    uint32_t key;
     char vesselName[VESSEL_NAME_LENGTH + 1]; 
-    // High-ceiling remaining lane length
-    double HRL;   
-    // Low-ceiling remaining lane length                           
-    double LRL;                              
+    // High-ceiling remaining lane length, in decimetres
+    int HRL;   
+    // Low-ceiling remaining lane length, in decimetres
+    int LRL;                              
 
     Sailing(); // Default constructor
 
@@ -45,7 +88,7 @@ public:
     // Initializes a sailing record with given parameters.
     //*********************************************************
     Sailing(const char *sailingId, const char *vesselName,
-                 double HRL, double LRL);
+                 int HRL, int LRL);
 
     //*********************************************************
     // writeToFile
@@ -63,6 +106,23 @@ public:
     //*********************************************************
     void readFromFile(fstream &file);
 
+    //*********************************************************
+    // readFromBuffer
+    //*********************************************************
+    // Fills this sailing from a record held in memory, e.g. a
+    // record handed out by RecordScanner.
+    // in: record - RECORD_SIZE bytes in file layout
+    //*********************************************************
+    void readFromBuffer(const char *record);
+
+    //*********************************************************
+    // writeToBuffer
+    //*********************************************************
+    // Stores this sailing in file layout.
+    // out: record - RECORD_SIZE bytes
+    //*********************************************************
+    void writeToBuffer(char *record) const;
+
     //*********************************************************
     // searchForSailing
     //*********************************************************
@@ -80,7 +140,7 @@ public:
     // in: sailingId, vesselName, HRL, LRL
     //*********************************************************
     void open(const string &sailingId, const string &vesselName,
-                         double HRL, double LRL);
+                         int HRL, int LRL);
 
     //*********************************************************
     // getSailingInfo
@@ -104,44 +164,78 @@ public:
     // writeSailing
     //*********************************************************
     // Appends a new sailing record to the sailing.dat file.
-    // in: sailingId, vesselName, HRL, LRL
+    // in: sailingId, vesselName, HRL, LRL - in decimetres
     // out: true if write successful
     //*********************************************************
     static bool writeSailing(string &sailingId, 
                             string &vesselName,
-                            double HRL, double LRL);
+                            int HRL, int LRL);
 
     //*********************************************************
     // removeSailing
     //*********************************************************
-    // Deletes a sailing record by copying others to a temp file.
+    // Deletes a sailing record by leaving a tombstone in its
+    // slot, compacting the file when tombstones pile up.
     // in: sailingId
     // out: true if successfully removed
     //*********************************************************
     static bool removeSailing(string sailingId);
 
+    //*********************************************************
+    // compactRecords
+    //*********************************************************
+    // Drops every tombstone from sailing.dat, moving the live
+    // records down and shortening the file.
+    // out: number of tombstones reclaimed
+    //*********************************************************
+    static int compactRecords();
+
     //*********************************************************
     // isSpaceAvailable
     //*********************************************************
     // Alternate version to check if a sailing has space
-    // in: sailingId, vehicleLength, isSpecial
+    // in: sailingId, vehicleLength, isSpecial (lengths in
+    // decimetres)
     // out: true if there’s enough HRL or LRL for the vehicle
     //*********************************************************
     static bool isSpaceAvailable(const string &sailingId, 
                                 bool isSpecial, 
-                                float vehicleLength, 
-                                float vehicleHeight);
+                                int vehicleLength, 
+                                int vehicleHeight);
 
     //*********************************************************
     // reduceSpace
     //*********************************************************
     // Deducts reserved vehicle length from LRL or HRL
-    // in-out: modifies sailing.dat
+    // in-out: modifies the capacity table
     //*********************************************************
     static void reduceSpace(const string &sailingId, 
-                            float vehicleLength, 
+                            int vehicleLength, 
                             bool isSpecial);
 
+    //*********************************************************
+    // tryReserveSpace
+    //*********************************************************
+    // Checks the lane the vehicle needs and deducts its
+    // length as one step. A process alone on the log
+    // (WriteAheadLog::isOnlyProcess) does it in one
+    // compare-and-swap on the capacity table, without a lock
+    // or disk access. While other processes share the files
+    // the record is re-read under its lock, their bookings
+    // are merged into the table, and the deduction is written
+    // back before the lock is released.
+    // in: sailingId, vehicleLength, isSpecial (lengths in
+    // decimetres)
+    // out: remainingHRL, remainingLRL - lane lengths after the
+    // booking (unchanged if it failed); true if space was
+    // reserved, false if the sailing is missing or full
+    //*********************************************************
+    static bool tryReserveSpace(const string &sailingId,
+                                int vehicleLength,
+                                bool isSpecial,
+                                int &remainingHRL,
+                                int &remainingLRL);
+
     //*********************************************************
     // addSpace
     //*********************************************************
@@ -149,7 +243,7 @@ public:
     // in-out: modifies sailing.dat
     //*********************************************************
     static void addSpace(const string &sailingId, 
-                        float vehicleLength, bool isSpecial);
+                        int vehicleLength, bool isSpecial);
 
     //*********************************************************
     // isValidSailingId()
@@ -161,21 +255,246 @@ public:
     //*********************************************************
     static bool isValidSailingId(const string &sailingId);
 
+    //*********************************************************
+    // isValidSailingId() with key
+    //*********************************************************
+    // Validates a sailing ID and encodes it as a 32-bit key:
+    // 6 bits per terminal letter (case kept), then 5 bits of
+    // day and 5 of hour. Keys sort by terminal, day, hour and
+    // are compared as plain integers; 0 is never a valid key.
+    // in: sailingId
+    // out: key - set when valid; true if valid
+    //*********************************************************
+    static bool isValidSailingId(const string &sailingId,
+                                uint32_t &key);
+
+    //*********************************************************
+    // sailingIdFromKey
+    //*********************************************************
+    // Decodes a key made by isValidSailingId.
+    // in: key
+    // out: the sailing ID in aaa-dd-hh form
+    //*********************************************************
+    static string sailingIdFromKey(uint32_t key);
+
+    //*********************************************************
+    // encodeTerminal
+    //*********************************************************
+    // Encodes a terminal (the aaa of aaa-dd-hh) the way
+    // isValidSailingId encodes it into a key.
+    // in: terminal - three letters
+    // out: code; true if terminal is valid
+    //*********************************************************
+    static bool encodeTerminal(const string &terminal,
+                                uint32_t &code);
+
+    //*********************************************************
+    // keyFor
+    //*********************************************************
+    // Builds a key from its fields. Day and hour may be any
+    // value that fits their bits (0-31), so that the keys
+    // bounding a range need not be real sailings; every
+    // sailing of a terminal lies between keyFor(t, 0, 0) and
+    // keyFor(t + 1, 0, 0).
+    // in: terminal - code from encodeTerminal, day, hour
+    // out: the key
+    //*********************************************************
+    static uint32_t keyFor(uint32_t terminal, int day, int hour);
+
+    //*********************************************************
+    // terminalOfKey
+    //*********************************************************
+    // in: key
+    // out: the terminal code of the key
+    //*********************************************************
+    static uint32_t terminalOfKey(uint32_t key);
+
     //*********************************************************
     // getHRL
     //*********************************************************
     // Getter for HRL of given sailingId
     // in: sailingId
-    // out: HRL as double
+    // out: HRL in decimetres, or -1 if not found
     //*********************************************************
-    double getHRL(const string &sailingId) const;
+    int getHRL(const string &sailingId) const;
 
     //*********************************************************
     // getLRL
     //*********************************************************
     // Getter for LRL of given sailingId
     // in: sailingId
-    // out: LRL as double
+    // out: LRL in decimetres, or -1 if not found
+    //*********************************************************
+    int getLRL(const string &sailingId) const;
+
+    //*********************************************************
+    // openIndex
     //*********************************************************
-    double getLRL(const string &sailingId) const;
-};
\ No newline at end of file
+    // Opens sailing.idx, rebuilding it from sailing.dat if it
+    // is missing or out of step, loads the capacity table and
+    // starts its write-back thread. Called by Util::startup.
+    //*********************************************************
+    static void openIndex();
+
+    //*********************************************************
+    // closeIndex
+    //*********************************************************
+    // Writes back pending lane changes and closes sailing.idx.
+    // Called by Util::shutdown.
+    //*********************************************************
+    static void closeIndex();
+
+    //*********************************************************
+    // flushCapacity
+    //*********************************************************
+    // Writes every pending lane change back to sailing.dat
+    // now. Called by WriteAheadLog::checkpoint.
+    //*********************************************************
+    static void flushCapacity();
+
+    //*********************************************************
+    // reloadCapacity
+    //*********************************************************
+    // Merges every sailing's lanes in sailing.dat, which
+    // other processes may have changed, into the capacity
+    // table and writes the result back, adding sailings they
+    // created. Called by WriteAheadLog once the other
+    // processes have left.
+    //*********************************************************
+    static void reloadCapacity();
+
+    //*********************************************************
+    // tallyReservations
+    //*********************************************************
+    // Counts the reservations and checked-in vehicles on every
+    // sailing and the lane length they take, each sized by
+    // its vehicle in vehicle.dat. vehicle.dat and
+    // reservation.dat are read by several threads in one pass
+    // each; both stay locked meanwhile.
+    // in: workers - number of threads; fewer than 1 means 1
+    // out: sailing key -> its tally; sailings with no
+    // reservations are left out
+    //*********************************************************
+    static unordered_map<uint32_t, Tally> tallyReservations(
+                                                int workers);
+
+    //*********************************************************
+    // rebuildCapacity
+    //*********************************************************
+    // Recomputes every sailing's HRL and LRL from its
+    // vessel's lane lengths, less each reservation on it (by
+    // its vehicle in vehicle.dat), and writes back the ones
+    // that disagree. reservation.dat and vehicle.dat are read
+    // by several threads in one pass each. Called by
+    // Util::startup after a run that did not shut down
+    // cleanly, before the log is replayed; other processes
+    // must not be booking meanwhile.
+    // out: number of sailings whose lanes were corrected
+    //*********************************************************
+    static int rebuildCapacity();
+
+private:
+    // Sailing ID -> slot in sailing.dat
+    static HashIndex index;
+    // sailing.dat, accessed through index
+    static RecordFile<Sailing, SailingKey> records;
+    // Remaining lanes of every sailing; the HRL and LRL in
+    // sailing.dat trail it and are written back in batches
+    static CapacityTable capacity;
+
+    //*********************************************************
+    // persistCapacity
+    //*********************************************************
+    // Writes a sailing's current lanes from the capacity
+    // table back to its record. Called by the flusher.
+    // in: key - encoded sailing ID
+    //*********************************************************
+    static void persistCapacity(uint32_t key);
+
+    //*********************************************************
+    // syncLanes
+    //*********************************************************
+    // Merges a record's lanes, as read under its record
+    // lock, with the capacity table.
+    // in-out: sailing - lanes to write back on return
+    // out: false if the sailing is not in the table
+    //*********************************************************
+    static bool syncLanes(Sailing &sailing);
+
+    //*********************************************************
+    // takeOnRecord
+    //*********************************************************
+    // tryReserveSpace while other processes share the files:
+    // the deduction is made with the record locked, after
+    // merging in the lanes on disk, and written back.
+    // in: key, highLane, needed, amount - in decimetres
+    // out: high, low - lanes after the call; true if the
+    // lane held needed and amount was taken
+    //*********************************************************
+    static bool takeOnRecord(uint32_t key, bool highLane,
+                                int needed, int amount,
+                                int &high, int &low);
+
+    // Bits per field of an encoded sailing ID
+    static const int LETTER_BITS = 6;
+    static const int DAY_BITS = 5;
+    static const int HOUR_BITS = 5;
+
+    //*********************************************************
+    // findRecord
+    //*********************************************************
+    // Looks a sailing up through the index and reads it,
+    // with HRL and LRL taken from the capacity table.
+    // in: key - encoded sailing ID
+    // out: foundSailing, slot of the record or -1
+    //*********************************************************
+    static int findRecord(uint32_t key, Sailing &foundSailing);
+
+    //*********************************************************
+    // keyOrZero
+    //*********************************************************
+    // in: sailingId
+    // out: its encoded key, or 0 if the ID is not valid
+    //*********************************************************
+    static uint32_t keyOrZero(const string &sailingId);
+
+    //*********************************************************
+    // findRecord by ID
+    //*********************************************************
+    // Same as above for a sailing ID in text form; an ID that
+    // is not valid is never found.
+    //*********************************************************
+    static int findRecord(const string &sailingId,
+                            Sailing &foundSailing);
+};
+
+//*********************************************************
+// SailingKey
+//*********************************************************
+// Key of a sailing record for RecordFile: the encoded
+// sailing ID at the start of the record. A deleted sailing
+// is left as a tombstone with key 0, which no sailing ID
+// encodes to.
+//*********************************************************
+struct SailingKey
+{
+    static const int LENGTH = Sailing::KEY_SIZE;
+    static const bool HAS_TOMBSTONES = true;
+
+    static void extract(const char *record, char *key)
+    {
+        memcpy(key, record, LENGTH);
+    }
+
+    static bool isLive(const char *record)
+    {
+        uint32_t key;
+        memcpy(&key, record, LENGTH);
+        return key != 0;
+    }
+
+    static void markDeleted(char *record)
+    {
+        memset(record, 0, LENGTH);
+    }
+};
@@ -5,6 +5,20 @@
 // Handles creation, deletion, reporting, and querying
 // sailings.
 // July 25, 2025 Version 2 - Yadhu
+// Oct 17, 2026 Version 3 - Team 18, per-sailing locking
+// Oct 17, 2026 Version 4 - Team 18, skip deleted sailings
+// Oct 17, 2026 Version 5 - Team 18, changes are committed
+// through the write-ahead log
+// Oct 17, 2026 Version 6 - Team 18, reports read a snapshot
+// of the versioned sailing table
+// Oct 17, 2026 Version 7 - Team 18, query and report read the
+// occupancy kept by SailingVersions
+// Oct 17, 2026 Version 8 - Team 18, report pages resume from
+// a cursor
+// Oct 17, 2026 Version 9 - Team 18, printAuditReport
+// Oct 17, 2026 Version 10 - Team 18, filtered sailing queries
+// Oct 17, 2026 Version 11 - Team 18, each change is logged
+// before it is made
 //*********************************************************
 
 #include "SailingControl.h"
@@ -12,10 +26,15 @@
 #include "Reservation.h"
 #include "Vessel.h"
 #include "Util.h"
+#include "WriteAheadLog.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <vector>
 #include <limits>
+#include <mutex>
+#include <unordered_map>
 using namespace std;
 
 //*********************************************************
@@ -37,6 +56,10 @@ SailingControl::SailingControl() {
 bool SailingControl::createSailing(const string& sailingId, 
                                 const string& vesselName) 
 {
+    shared_lock<shared_mutex> logged = 
+                            WriteAheadLog::beginOperation();
+    unique_lock<mutex> stripe(Util::sailingStripe(sailingId));
+
     if (!Sailing::isValidSailingId(sailingId)) {
         cout << "Invalid sailing ID format.";
         cout << "Must be in format: aaa-dd-hh "
@@ -53,20 +76,36 @@ bool SailingControl::createSailing(const string& sailingId,
         return false;
     }
 
-    int hcll = Vessel::getHCLL(vesselName);
-    int lcll = Vessel::getLCLL(vesselName);
+    // Vessel lanes are whole metres; sailings keep decimetres
+    int hcll = Vessel::getHCLL(vesselName) 
+                * Util::DECIMETRES_PER_METRE;
+    int lcll = Vessel::getLCLL(vesselName)
+                * Util::DECIMETRES_PER_METRE;
+
+    WriteAheadLog::Entry entry(WriteAheadLog::CREATE_SAILING);
+    Sailing::isValidSailingId(sailingId, entry.sailingKey);
+    WriteAheadLog::copyField(entry.vesselName, 
+                        sizeof(entry.vesselName), vesselName);
+    if (!WriteAheadLog::commit(WriteAheadLog::append(entry))) {
+        cout << "The sailing could not be logged." << endl;
+        return false;
+    }
 
-    return Sailing::writeSailing(
+    if (!Sailing::writeSailing(
         const_cast<string&>(sailingId),
         const_cast<string&>(vesselName),
-        hcll, lcll);
+        hcll, lcll)) {
+        return false;
+    }
+    SailingVersions::addSailing(sailingId, vesselName, hcll, lcll);
+    return true;
 }
 
 //*********************************************************
 // deleteSailing
 //*********************************************************
 // Deletes a sailing record and removes all associated
-// reservations.
+// reservations, after asking the user to confirm.
 // in: sailingId (string)
 // out: true if deletion was successful, false if sailing
 // doesn't exist
@@ -81,16 +120,8 @@ bool SailingControl::deleteSailing(const string& sailingId)
             << "deleting the sailing [y/n]:"<<endl;
         cin >> input;
         cin.ignore(numeric_limits<streamsize>::max(),'\n');
-        if(input == 'y' || input == 'Y')
-        {
-            Reservation reservation;
-            reservation.removeReservationsOnSailing(sailingId);
-            return Sailing::removeSailing(sailingId);
-        }
-        else{
-            cout << "Sailing could not delete" << endl;
-            return false;
-        }
+        return deleteSailing(sailingId, 
+                            input == 'y' || input == 'Y');
     }
     else 
     {
@@ -100,100 +131,201 @@ bool SailingControl::deleteSailing(const string& sailingId)
     
 }
 
+//*********************************************************
+// deleteSailing (no prompt)
+//*********************************************************
+// Deletes a sailing and its reservations if the caller has
+// already confirmed.
+// in: sailingId, confirmed
+// out: true if deletion was successful
+//*********************************************************
+bool SailingControl::deleteSailing(const string& sailingId,
+                                    bool confirmed) 
+{
+    if (!confirmed)
+    {
+        cout << "Sailing could not delete" << endl;
+        return false;
+    }
+
+    shared_lock<shared_mutex> logged = 
+                            WriteAheadLog::beginOperation();
+    unique_lock<mutex> stripe(Util::sailingStripe(sailingId));
+
+    if (!Sailing::checkExist(sailingId)) 
+    {
+        cout << "Sailing does not exist." << endl;
+        return false;
+    }
+
+    WriteAheadLog::Entry entry(WriteAheadLog::DELETE_SAILING);
+    Sailing::isValidSailingId(sailingId, entry.sailingKey);
+    if (!WriteAheadLog::commit(WriteAheadLog::append(entry)))
+    {
+        cout << "The deletion could not be logged." << endl;
+        return false;
+    }
+
+    Reservation reservation;
+    reservation.removeReservationsOnSailing(sailingId);
+    if (!Sailing::removeSailing(sailingId))
+    {
+        return false;
+    }
+    SailingVersions::removeSailing(sailingId);
+    return true;
+}
+
 //*********************************************************
 // querySailing
 //*********************************************************
 // Retrieves a sailing by ID and prints all relevant details
-// including HRL, LRL, vehicle count, and capacity percentage.
+// including HRL, LRL, vehicle and check-in counts, and
+// capacity percentage.
 // in: sailingId (string)
 //*********************************************************
 void SailingControl::querySailing(const string& sailingId) 
 {
-    if (!Sailing::checkExist(sailingId)) {
-        cout << "No sailing with ID '" << sailingId 
+    querySailing(sailingId, cout);
+}
+
+//*********************************************************
+// querySailing (to a stream)
+//*********************************************************
+// Same details as querySailing(), written to out.
+// in: sailingId, out
+//*********************************************************
+bool SailingControl::querySailing(const string& sailingId,
+                                    ostream &out) 
+{
+    uint32_t key = 0;
+    SailingVersions::Row row;
+    if (!Sailing::isValidSailingId(sailingId, key)
+        || !SailingVersions::read(key, row)) {
+        out << "No sailing with ID '" << sailingId 
             << "' exists." << endl;
-        return;
+        return false;
     }
 
-    Sailing sailing = Sailing::getSailingInfo(sailingId);
-
-    cout << "\n========== Sailing Details ==========\n";
-    cout << "Sailing ID: " << sailingId << endl;
-    cout << "Vessel Name: " << sailing.vesselName << endl;
-
-    int totalVehicles = 
-    Reservation::getTotalReservationsOnSailing(sailingId);
+    out << "\n========== Sailing Details ==========\n";
+    out << "Sailing ID: " << sailingId << endl;
+    out << "Vessel Name: " << row.vesselName << endl;
 
-    double totalCapacity = Vessel::getCapacity(sailing.vesselName);
+    double percent = percentFull(row);
 
-    double totalUsed = totalCapacity - (sailing.HRL + sailing.LRL);
-
-    double percent = (totalUsed > 0.0) ? 
-                    ((totalUsed / totalCapacity) 
-                    * 100.0) : 0.0;
-
-    cout << "High Remaining Capacity (HRL): " 
-        << fixed << setprecision(1) << sailing.HRL 
+    out << "High Remaining Capacity (HRL): " 
+        << fixed << setprecision(1) 
+        << Util::toMetres(row.HCLL - row.usedHigh) 
         << " m" << endl;
-    cout << "Low Remaining Capacity (LRL): " 
-        << fixed << setprecision(1) << sailing.LRL 
+    out << "Low Remaining Capacity (LRL): " 
+        << fixed << setprecision(1) 
+        << Util::toMetres(row.LCLL - row.usedLow) 
         << " m" << endl;
-    cout << "Total Vehicles on Board: " 
-        << totalVehicles << endl;
-    cout << "Capacity Used: " << fixed 
+    out << "Total Vehicles on Board: " 
+        << row.vehicles << endl;
+    out << "Vehicles Checked In: " 
+        << row.checkedIn << endl;
+    out << "Capacity Used: " << fixed 
         << setprecision(1) << percent << "%\n";
+    return true;
 }
 
 //*********************************************************
-// printSailingReport
+// querySailings
 //*********************************************************
-// Displays a multi-entry report of all sailings stored
-// in the file.
-// Allows users to view reports in chunks of 5 with paging
-// prompt.
+// Walks the snapshot cursor through the window of one
+// terminal after another. A row before the window moves the
+// cursor to its start and a row past it to the end of its
+// terminal, so rows outside the window are passed over one
+// terminal at a time, each jump a single lookup.
+// in: filter, out
+// out: false if the filter is not valid
 //*********************************************************
-void SailingControl::printSailingReport() {
-    fstream file("sailing.dat", ios::in | ios::binary);
-    if (!file.is_open()) {
-        cout << "Unable to open sailing.dat for reading."
-            << endl;
-        return;
+bool SailingControl::querySailings(const Filter &filter, 
+                                    ostream &out)
+{
+    uint32_t onlyTerminal = 0;
+    if (!filter.terminal.empty() 
+        && !Sailing::encodeTerminal(filter.terminal, onlyTerminal)) {
+        return false;
+    }
+    if (filter.fromDay < 1 || filter.toDay > 31
+        || filter.fromHour < 0 || filter.fromHour > 23
+        || filter.toHour < 0 || filter.toHour > 23
+        || filter.fromDay * 24 + filter.fromHour 
+            > filter.toDay * 24 + filter.toHour) {
+        return false;
     }
 
-    vector<string> sailingIds;
-    Sailing sailing;
-
-    // Collect sailing IDs from file
-    while (true)
-    {
-        Sailing sailing;
-
-        if (!file.read(sailing.sailingId, 
-            Sailing::SAILING_ID_LENGTH + 1)) break;
-
-        if (!file.read(sailing.vesselName, 
-            Sailing::VESSEL_NAME_LENGTH + 1)) break;
+    SailingVersions::Snapshot snapshot;
+    SailingVersions::Row row;
+    uint32_t key = filter.terminal.empty() ? 0
+        : Sailing::keyFor(onlyTerminal, filter.fromDay,
+                            filter.fromHour) - 1;
+    int matches = 0;
+
+    while (snapshot.next(key, row)) {
+        uint32_t terminal = Sailing::terminalOfKey(key);
+        if (!filter.terminal.empty() && terminal != onlyTerminal) {
+            break; // Past the only terminal asked for
+        }
 
-        if (!file.read(reinterpret_cast
-            <char*>(&sailing.HRL), sizeof(double))) break;
+        uint32_t first = Sailing::keyFor(terminal, filter.fromDay,
+                                        filter.fromHour);
+        uint32_t last = Sailing::keyFor(terminal, filter.toDay,
+                                        filter.toHour);
+        if (key < first) {
+            key = first - 1;
+            continue;
+        }
+        if (key > last) {
+            key = Sailing::keyFor(terminal + 1, 0, 0) - 1;
+            continue;
+        }
 
-        if (!file.read(reinterpret_cast
-            <char*>(&sailing.LRL), sizeof(double))) break;
+        if (percentFull(row) > filter.overPercentFull) {
+            if (matches == 0) {
+                printReportHeader(out);
+            }
+            printReportRow(out, key, row);
+            matches++;
+        }
+    }
 
-        sailingIds.push_back(string(sailing.sailingId));
+    if (matches == 0) {
+        out << "No sailings match." << endl;
+    } else {
+        out << "------------------------------------------------------------------------------\n";
     }
+    return true;
+}
 
-    file.close();
+//*********************************************************
+// percentFull
+//*********************************************************
+// in: row
+// out: % of the sailing's lane length occupied
+//*********************************************************
+double SailingControl::percentFull(const SailingVersions::Row &row)
+{
+    double totalCapacity = row.HCLL + row.LCLL;
 
-    if (sailingIds.empty()) {
-        cout << "No sailings available to display." 
-            << endl;
-        return;
-    }
+    double totalUsed = row.usedHigh + row.usedLow;
 
-    // Header
-    cout << "=============================== Sailing Report ===============================\n";
-    cout << left
+    return (totalUsed > 0.0) ? 
+            ((totalUsed / totalCapacity) * 100.0) : 0.0;
+}
+
+//*********************************************************
+// printReportHeader
+//*********************************************************
+// Writes the column headings of the sailing report.
+// in: out
+//*********************************************************
+void SailingControl::printReportHeader(ostream &out)
+{
+    out << "=============================== Sailing Report ===============================\n";
+    out << left
          << setw(10) << "Date"
          << setw(15) << "Sailing_ID"
          << setw(20) << "Vessel name"
@@ -206,45 +338,121 @@ void SailingControl::printSailingReport() {
          << setw(12) << "Vehicles"
          << "occupied"
          << endl;
+}
 
-    size_t count = 0;
+//*********************************************************
+// printReportRow
+//*********************************************************
+// Writes the report line for one sailing.
+// in: out, key - encoded sailing ID, row
+//*********************************************************
+void SailingControl::printReportRow(ostream &out, uint32_t key,
+                            const SailingVersions::Row &row)
+{
+    string sailingId = Sailing::sailingIdFromKey(key);
+    string date = sailingId.substr(sailingId.find('-') + 1); 
+    double percent = percentFull(row);
+    out << left
+         << setw(10) << date
+         << setw(15) << sailingId
+         << setw(20) << row.vesselName
+         << setw(6)  << Util::toMetres(row.LCLL - row.usedLow)
+         << setw(6)  << Util::toMetres(row.HCLL - row.usedHigh)
+         << setw(12)  << row.vehicles
+         << fixed << setprecision(1) << percent 
+         << endl;
+}
+
+//*********************************************************
+// printReportPage (from a snapshot)
+//*********************************************************
+// Writes the lines of one page, straight off the snapshot's
+// cursor, so no sailing is looked up twice.
+// in: out, snapshot, rows
+// in-out: key - last key written
+// out: true if more sailings follow
+//*********************************************************
+bool SailingControl::printReportPage(ostream &out,
+                        const SailingVersions::Snapshot &snapshot,
+                        uint32_t &key, int rows)
+{
+    SailingVersions::Row row;
+    for (int i = 0; i < rows && snapshot.next(key, row); ++i) {
+        printReportRow(out, key, row);
+    }
+
+    // Look one past the page without moving the cursor
+    uint32_t following = key;
+    return snapshot.next(following, row);
+}
+
+//*********************************************************
+// printReportPage (from a cursor)
+//*********************************************************
+// One page for a client that comes back for the next one,
+// e.g. over the reservation server. Sailings are in key
+// order, so the page resumes right after the cursor's key
+// even if that sailing has since been deleted.
+// in: out, rows
+// in-out: cursor - sailing ID of the last line written
+// out: true if more sailings follow
+//*********************************************************
+bool SailingControl::printReportPage(ostream &out, string &cursor,
+                                    int rows)
+{
+    uint32_t key = 0;
+    if (!cursor.empty() && !Sailing::isValidSailingId(cursor, key)) {
+        return false;
+    }
+
+    SailingVersions::Snapshot snapshot;
+    printReportHeader(out);
+    bool more = printReportPage(out, snapshot, key, rows);
+    if (key != 0) {
+        cursor = Sailing::sailingIdFromKey(key);
+    }
+    return more;
+}
+
+//*********************************************************
+// printSailingReport
+//*********************************************************
+// Displays a multi-entry report of all sailings stored
+// in the file.
+// Allows users to view reports in chunks of 5 with paging
+// prompt. Every page comes from the same snapshot, so the
+// report stays consistent while bookings carry on.
+//*********************************************************
+void SailingControl::printSailingReport() {
+    if (!Util::sailingFile.is_open()) {
+        cout << "Unable to open sailing.dat for reading."
+            << endl;
+        return;
+    }
+
+    SailingVersions::Snapshot snapshot;
+    uint32_t key = 0;
+    SailingVersions::Row row;
+
+    if (!snapshot.next(key, row)) {
+        cout << "No sailings available to display." 
+            << endl;
+        return;
+    }
+
+    // Header
+    printReportHeader(cout);
 
     // Display sailings in groups of 5
-    while (count < sailingIds.size()) {
-        size_t batchEnd = min(count + 5, 
-                              sailingIds.size());
-        for (size_t i = count; i < batchEnd; ++i) {
-            Sailing s = 
-                Sailing::getSailingInfo(sailingIds[i]);
-            
-            string date = sailingIds[i].
-                substr(sailingIds[i].find('-') + 1); 
-            int totalVehicles = Reservation::
-                getTotalReservationsOnSailing(s.sailingId);
-            double totalCapacity = 
-                        Vessel::getCapacity(s.vesselName);
-
-            double totalUsed = totalCapacity - 
-                                (s.HRL + s.LRL);
-
-            double percent = (totalUsed > 0.0) ? 
-                            ((totalUsed / totalCapacity) 
-                            * 100.0) : 0.0;
-            cout << left
-                 << setw(10) << date
-                 << setw(15) << s.sailingId
-                 << setw(20) << s.vesselName
-                 << setw(6)  << s.LRL
-                 << setw(6)  << s.HRL
-                 << setw(12)  << totalVehicles
-                 << fixed << setprecision(1) << percent 
-                 << endl;
-        }
+    key = 0;
+    bool more = true;
+    while (more) {
+        more = printReportPage(cout, snapshot, key,
+                                REPORT_PAGE_SIZE);
 
-        count = batchEnd;
         cout << "------------------------------------------------------------------------------\n";
 
-        if (count >= sailingIds.size()) break;
+        if (!more) break;
 
         // Prompt user to continue or stop
         cout << "\nShow more sailings? (y/n): ";
@@ -253,19 +461,136 @@ void SailingControl::printSailingReport() {
         cin.ignore(numeric_limits<streamsize>::max(),
              '\n');
         if (tolower(choice) != 'y') break;
-        cout << "=============================== Sailing Report ===============================\n";
-        cout << left
-             << setw(10) << "Date"
-             << setw(15) << "Sailing_ID"
-             << setw(20) << "Vessel name"
-             << setw(6)  << "LRL"
-             << setw(6)  << "HRL"
-             << setw(12)  << "Total"
-             << "% of lane\n"
-             << setw(10) << "&Time"
-             << setw(47) << ""
-             << setw(12) << "Vehicles"
-             << "occupied"
-             << endl;
+        printReportHeader(cout);
+    }
+}
+
+//*********************************************************
+// printSailingReport (to a stream)
+//*********************************************************
+// Writes the whole report to out in one go, without paging.
+// in: out
+//*********************************************************
+void SailingControl::printSailingReport(ostream &out) {
+    if (!Util::sailingFile.is_open()) {
+        out << "Unable to open sailing.dat for reading."
+            << endl;
+        return;
+    }
+
+    SailingVersions::Snapshot snapshot;
+    uint32_t key = 0;
+    SailingVersions::Row row;
+
+    if (!snapshot.next(key, row)) {
+        out << "No sailings available to display." 
+            << endl;
+        return;
+    }
+
+    printReportHeader(out);
+    key = 0;
+    printReportPage(out, snapshot, key, numeric_limits<int>::max());
+    out << "------------------------------------------------------------------------------\n";
+}
+
+//*********************************************************
+// printAuditReport
+//*********************************************************
+// Tallies the reservations, reads the sailings with one
+// list per worker, then merges the lists in key order and
+// prints them like printSailingReport.
+// in: out, workers
+//*********************************************************
+void SailingControl::printAuditReport(ostream &out, int workers)
+{
+    workers = max(workers, 1);
+
+    // Every file is held for the whole pass, in the controls'
+    // lock order, so the tallies and the sailings are read at
+    // one moment: no change can land between the two reads
+    lock_guard<OwnedMutex> vesselLock(Util::vesselLock);
+    lock_guard<OwnedMutex> sailingLock(Util::sailingLock);
+    lock_guard<OwnedMutex> reservationLock(
+                                    Util::reservationLock);
+    lock_guard<OwnedMutex> vehicleLock(Util::vehicleLock);
+
+    unordered_map<uint32_t, Sailing::Tally> tallies = 
+                            Sailing::tallyReservations(workers);
+
+    RecordFile<Sailing, SailingKey> sailingRecords(
+                    Util::sailingFile, Util::sailingFileLock,
+                    "sailing.dat");
+    vector<vector<Sailing>> sailingParts(workers);
+    sailingRecords.parallelScan(workers,
+        [&](const char *record, int, int worker)
+    {
+        Sailing sailing;
+        sailing.readFromBuffer(record);
+        sailingParts[worker].push_back(sailing);
+    });
+
+    // Vessel lanes are looked up here, once per vessel, since
+    // the catalog lock is held by this thread
+    unordered_map<string, pair<int, int>> lanes;
+    vector<pair<uint32_t, SailingVersions::Row>> rows;
+    for (auto &part : sailingParts)
+    {
+        for (Sailing &sailing : part)
+        {
+            auto vessel = lanes.find(sailing.vesselName);
+            if (vessel == lanes.end())
+            {
+                vessel = lanes.emplace(sailing.vesselName,
+                    make_pair(Vessel::getHCLL(sailing.vesselName),
+                            Vessel::getLCLL(sailing.vesselName)))
+                    .first;
+            }
+
+            const Sailing::Tally &tally = tallies[sailing.key];
+            SailingVersions::Row row;
+            memset(&row, 0, sizeof(row));
+            row.live = true;
+            memcpy(row.vesselName, sailing.vesselName,
+                    sizeof(row.vesselName));
+            row.usedHigh = tally.usedHigh;
+            row.usedLow = tally.usedLow;
+            row.vehicles = tally.vehicles;
+            row.checkedIn = tally.checkedIn;
+            if (vessel->second.first < 0 || vessel->second.second < 0)
+            {
+                // Vessel unknown: keep the lanes on record
+                row.HCLL = sailing.HRL + row.usedHigh;
+                row.LCLL = sailing.LRL + row.usedLow;
+            }
+            else
+            {
+                row.HCLL = vessel->second.first
+                            * Util::DECIMETRES_PER_METRE;
+                row.LCLL = vessel->second.second
+                            * Util::DECIMETRES_PER_METRE;
+            }
+            rows.push_back(make_pair(sailing.key, row));
+        }
+        part.clear();
+    }
+
+    if (rows.empty()) {
+        out << "No sailings available to display." 
+            << endl;
+        return;
     }
-}
\ No newline at end of file
+
+    sort(rows.begin(), rows.end(),
+        [](const pair<uint32_t, SailingVersions::Row> &a,
+            const pair<uint32_t, SailingVersions::Row> &b)
+    {
+        return a.first < b.first;
+    });
+
+    printReportHeader(out);
+    for (auto &row : rows) {
+        printReportRow(out, row.first, row.second);
+    }
+    out << "------------------------------------------------------------------------------\n";
+}
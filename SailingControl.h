@@ -9,18 +9,47 @@
 // Interfaces with the Sailing entity and the Reservation
 // module.
 // July 20, 2025 Version 3 - Team 18
+// Oct 17, 2026 Version 4 - Team 18, stream and no-prompt
+// variants for the reservation server
+// Oct 17, 2026 Version 5 - Team 18, reports read a snapshot
+// Oct 17, 2026 Version 6 - Team 18, report pages resume from
+// a cursor
+// Oct 17, 2026 Version 7 - Team 18, printAuditReport
+// Oct 17, 2026 Version 8 - Team 18, filtered sailing queries
 //*********************************************************
 
 #pragma once
 
 #include "Sailing.h"
+#include "SailingVersions.h"
+#include <ostream>
 #include <string>
+#include <vector>
 
 using namespace std;
 
 class SailingControl
 {
 public:
+    //*********************************************************
+    // Filter
+    //*********************************************************
+    // Which sailings querySailings reports. Departures are
+    // compared as (day, hour), both ends included.
+    //*********************************************************
+    struct Filter
+    {
+        // Three-letter terminal, or empty for every terminal
+        string terminal;
+        int fromDay = 1;
+        int fromHour = 0;
+        int toDay = 31;
+        int toHour = 23;
+        // Only sailings with more than this % of lane length
+        // occupied; below 0 for any
+        double overPercentFull = -1;
+    };
+
     //*********************************************************
     // Default Constructor
     //*********************************************************
@@ -43,6 +72,16 @@ public:
     //*********************************************************
     static bool deleteSailing(const string &sailingId);
 
+    //*********************************************************
+    // Deletes a sailing and its reservations without asking;
+    // the caller has already confirmed
+    // in: sailingId - unique sailing identifier
+    //     confirmed - false cancels the deletion
+    // out: true if deletion succeeded, false otherwise
+    //*********************************************************
+    static bool deleteSailing(const string &sailingId, 
+                                bool confirmed);
+
     //*********************************************************
     // Displays details of a specific sailing
     // in: sailingId - unique sailing identifier
@@ -51,8 +90,87 @@ public:
     static void querySailing(const string &sailingId);
 
     //*********************************************************
-    // Generates a formatted report of all sailings
+    // Writes the details of a specific sailing to a stream
+    // in: sailingId - unique sailing identifier
+    //     out - stream to write to
+    // out: true if the sailing exists
+    //*********************************************************
+    static bool querySailing(const string &sailingId, 
+                                ostream &out);
+
+    //*********************************************************
+    // Writes the report lines of the sailings that pass a
+    // filter, in sailing ID order, from one snapshot. The
+    // sailings are kept in key order (terminal, day, hour),
+    // so only the departure window of each terminal is read,
+    // not the whole table.
+    // in: filter, out - stream to write to
+    // out: false if the filter is not valid
+    //*********************************************************
+    static bool querySailings(const Filter &filter, ostream &out);
+
+    //*********************************************************
+    // Generates a formatted report of all sailings, in
+    // sailing ID order, as of the moment it starts
     // out: prints multiple sailings with paging
     //*********************************************************
     static void printSailingReport();
+
+    //*********************************************************
+    // Writes the whole sailing report to a stream, no paging
+    // in: out - stream to write to
+    //*********************************************************
+    static void printSailingReport(ostream &out);
+
+    //*********************************************************
+    // Writes one page of the sailing report to a stream,
+    // resuming after the last sailing of the previous page.
+    // Each page reads its own snapshot, so memory stays the
+    // same however long the report is. A page seeks to the
+    // cursor and closing its snapshot prunes only sailings
+    // changed meanwhile, so a page costs its own lines, not
+    // the whole report.
+    // in: out - stream to write to
+    //     rows - most report lines to write
+    // in-out: cursor - sailing ID of the last line of the
+    //         previous page, empty to start; set to the last
+    //         line written
+    // out: true if more sailings follow the page
+    //*********************************************************
+    static bool printReportPage(ostream &out, string &cursor,
+                                int rows);
+
+    //*********************************************************
+    // Writes the sailing report recounted from the data files
+    // instead of the occupancy view, e.g. for the month-end
+    // review. sailing.dat, reservation.dat and vehicle.dat
+    // are each split among the workers. The vessel, sailing,
+    // reservation and vehicle locks are held for the whole
+    // pass, so the counts are of one moment: operations of
+    // this process that change a file wait until it is done,
+    // while other processes are only kept out of the range
+    // being read. Lanes taken in the capacity table by a
+    // booking still in progress are not counted until its
+    // reservation is written.
+    // in: out - stream to write to
+    //     workers - number of threads; fewer than 1 means 1
+    //*********************************************************
+    static void printAuditReport(ostream &out, int workers);
+
+private:
+    // Report lines shown per page
+    static const int REPORT_PAGE_SIZE = 5;
+
+    // Report column headings
+    static void printReportHeader(ostream &out);
+    // % of the sailing's lane length occupied
+    static double percentFull(const SailingVersions::Row &row);
+    // One report line, from a snapshot row
+    static void printReportRow(ostream &out, uint32_t key,
+                        const SailingVersions::Row &row);
+    // Up to rows report lines after key from a snapshot,
+    // moving key to the last one; true if more follow
+    static bool printReportPage(ostream &out,
+                        const SailingVersions::Snapshot &snapshot,
+                        uint32_t &key, int rows);
 };
\ No newline at end of file
@@ -0,0 +1,410 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// SailingVersions.cpp
+//*********************************************************
+// Purpose: Implements the versioned sailing table and its
+// snapshots.
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, occupancy kept by deltas
+// Oct 17, 2026 Version 3 - Team 18, prune only stale sailings
+// Oct 17, 2026 Version 4 - Team 18, read
+//*********************************************************
+
+#include "SailingVersions.h"
+#include "Reservation.h"
+#include "Vessel.h"
+#include "Util.h"
+#include "RecordScanner.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+
+using namespace std;
+
+mutex SailingVersions::tableLock;
+map<uint32_t, vector<SailingVersions::Row>> SailingVersions::rows;
+uint64_t SailingVersions::clock = 0;
+multiset<uint64_t> SailingVersions::snapshots;
+set<uint32_t> SailingVersions::stale;
+
+//*********************************************************
+// Snapshot constructor
+//*********************************************************
+SailingVersions::Snapshot::Snapshot()
+{
+    lock_guard<mutex> lock(tableLock);
+    version = clock;
+    snapshots.insert(version);
+}
+
+//*********************************************************
+// Snapshot destructor
+// Once the oldest snapshot closes, the versions only it
+// could see are dropped from the sailings that have more
+// than one
+//*********************************************************
+SailingVersions::Snapshot::~Snapshot()
+{
+    lock_guard<mutex> lock(tableLock);
+    bool oldest = snapshots.begin() != snapshots.end()
+                    && *snapshots.begin() == version;
+    snapshots.erase(snapshots.find(version));
+
+    if (!oldest)
+    {
+        return;
+    }
+
+    for (auto key = stale.begin(); key != stale.end(); )
+    {
+        auto entry = rows.find(*key);
+        if (entry != rows.end() && !prune(entry->second))
+        {
+            rows.erase(entry);
+            entry = rows.end();
+        }
+
+        if (entry == rows.end() || entry->second.size() == 1)
+        {
+            key = stale.erase(key);
+        }
+        else
+        {
+            ++key;
+        }
+    }
+}
+
+//*********************************************************
+// Snapshot::next()
+//*********************************************************
+bool SailingVersions::Snapshot::next(uint32_t &key,
+                                    Row &row) const
+{
+    lock_guard<mutex> lock(tableLock);
+    for (auto entry = rows.upper_bound(key); entry != rows.end();
+            ++entry)
+    {
+        const Row *seen = visible(entry->second, version);
+        if (seen != nullptr && seen->live)
+        {
+            key = entry->first;
+            row = *seen;
+            return true;
+        }
+    }
+    return false;
+}
+
+//*********************************************************
+// Snapshot::find()
+//*********************************************************
+bool SailingVersions::Snapshot::find(uint32_t key,
+                                    Row &row) const
+{
+    lock_guard<mutex> lock(tableLock);
+    auto entry = rows.find(key);
+    if (entry == rows.end())
+    {
+        return false;
+    }
+
+    const Row *seen = visible(entry->second, version);
+    if (seen == nullptr || !seen->live)
+    {
+        return false;
+    }
+
+    row = *seen;
+    return true;
+}
+
+//*********************************************************
+// load()
+// Lanes used come from the capacity table, and vehicles and
+// check-ins from one pass over reservation.dat with a count
+// per worker, merged at the end
+//*********************************************************
+void SailingVersions::load()
+{
+    // Same lock order as the controls
+    lock_guard<OwnedMutex> vesselLock(Util::vesselLock);
+    lock_guard<OwnedMutex> sailingLock(Util::sailingLock);
+    lock_guard<OwnedMutex> reservationLock(
+                                    Util::reservationLock);
+
+    int workers = max(1u, thread::hardware_concurrency());
+    RecordFile<Reservation, ReservationKey> reservations(
+            Util::reservationFile, Util::reservationFileLock,
+            "reservation.dat");
+    // Sailing key -> vehicles and vehicles checked in
+    vector<unordered_map<uint32_t, pair<int, int>>> countParts(
+                                                    workers);
+    reservations.parallelScan(workers,
+        [&](const char *record, int, int worker)
+    {
+        Reservation reservation;
+        reservation.readFromBuffer(record);
+        pair<int, int> &count = 
+                    countParts[worker][reservation.sailingKey];
+        count.first++;
+        count.second += reservation.onBoard ? 1 : 0;
+    });
+
+    unordered_map<uint32_t, pair<int, int>> counts;
+    for (auto &part : countParts)
+    {
+        for (auto &sailing : part)
+        {
+            pair<int, int> &total = counts[sailing.first];
+            total.first += sailing.second.first;
+            total.second += sailing.second.second;
+        }
+    }
+
+    // The sailings are collected first, since the lane
+    // lookups below use the same stream as the scan
+    vector<Sailing> sailings;
+    {
+        RecordScanner scanner(Util::sailingFile,
+                                Sailing::RECORD_SIZE);
+        const char *record;
+        while ((record = scanner.next()) != nullptr)
+        {
+            Sailing sailing;
+            sailing.readFromBuffer(record);
+            if (sailing.key != 0)
+            {
+                sailings.push_back(sailing);
+            }
+        }
+    }
+
+    vector<pair<uint32_t, Row>> loaded;
+    for (Sailing &sailing : sailings)
+    {
+        // Current lanes, which may be ahead of the record
+        Sailing::searchForSailing(sailing.sailingId, sailing);
+
+        Row row;
+        memset(&row, 0, sizeof(row));
+        row.live = true;
+        memcpy(row.vesselName, sailing.vesselName,
+                sizeof(row.vesselName));
+        row.HCLL = Vessel::getHCLL(sailing.vesselName)
+                    * Util::DECIMETRES_PER_METRE;
+        row.LCLL = Vessel::getLCLL(sailing.vesselName)
+                    * Util::DECIMETRES_PER_METRE;
+        if (row.HCLL < 0 || row.LCLL < 0)
+        {
+            // Vessel unknown: count the lanes left as empty
+            row.HCLL = sailing.HRL;
+            row.LCLL = sailing.LRL;
+        }
+        row.usedHigh = row.HCLL - sailing.HRL;
+        row.usedLow = row.LCLL - sailing.LRL;
+        row.vehicles = counts[sailing.key].first;
+        row.checkedIn = counts[sailing.key].second;
+        loaded.push_back(make_pair(sailing.key, row));
+    }
+
+    lock_guard<mutex> lock(tableLock);
+    rows.clear();
+    stale.clear();
+    for (auto &sailing : loaded)
+    {
+        publish(sailing.first, sailing.second);
+    }
+}
+
+//*********************************************************
+// read()
+//*********************************************************
+bool SailingVersions::read(uint32_t key, Row &row)
+{
+    lock_guard<mutex> lock(tableLock);
+    auto entry = rows.find(key);
+    if (entry == rows.end() || !entry->second.back().live)
+    {
+        return false;
+    }
+
+    row = entry->second.back();
+    return true;
+}
+
+//*********************************************************
+// addSailing()
+//*********************************************************
+void SailingVersions::addSailing(const string &sailingId,
+                                const string &vesselName,
+                                int HCLL, int LCLL)
+{
+    uint32_t key;
+    if (!Sailing::isValidSailingId(sailingId, key))
+    {
+        return;
+    }
+
+    Row row;
+    memset(&row, 0, sizeof(row));
+    row.live = true;
+    strncpy(row.vesselName, vesselName.c_str(),
+            Sailing::VESSEL_NAME_LENGTH);
+    row.HCLL = HCLL;
+    row.LCLL = LCLL;
+
+    lock_guard<mutex> lock(tableLock);
+    publish(key, row);
+}
+
+//*********************************************************
+// removeSailing()
+//*********************************************************
+void SailingVersions::removeSailing(const string &sailingId)
+{
+    change(sailingId, [](Row &row)
+    {
+        row.live = false;
+    });
+}
+
+//*********************************************************
+// reserve()
+//*********************************************************
+void SailingVersions::reserve(const string &sailingId,
+                                bool highLane, int vehicleLength)
+{
+    change(sailingId, [&](Row &row)
+    {
+        int &used = highLane ? row.usedHigh : row.usedLow;
+        used += vehicleLength + Sailing::VEHICLE_GAP;
+        row.vehicles++;
+    });
+}
+
+//*********************************************************
+// cancel()
+//*********************************************************
+void SailingVersions::cancel(const string &sailingId,
+                            bool highLane, int vehicleLength,
+                            bool checkedIn)
+{
+    change(sailingId, [&](Row &row)
+    {
+        int &used = highLane ? row.usedHigh : row.usedLow;
+        used -= vehicleLength + Sailing::VEHICLE_GAP;
+        row.vehicles--;
+        row.checkedIn -= checkedIn ? 1 : 0;
+    });
+}
+
+//*********************************************************
+// checkIn()
+//*********************************************************
+void SailingVersions::checkIn(const string &sailingId)
+{
+    change(sailingId, [](Row &row)
+    {
+        row.checkedIn++;
+    });
+}
+
+//*********************************************************
+// change()
+//*********************************************************
+void SailingVersions::change(const string &sailingId,
+                            function<void(Row &row)> update)
+{
+    uint32_t key;
+    if (!Sailing::isValidSailingId(sailingId, key))
+    {
+        return;
+    }
+
+    lock_guard<mutex> lock(tableLock);
+    auto entry = rows.find(key);
+    if (entry == rows.end() || !entry->second.back().live)
+    {
+        return;
+    }
+
+    Row row = entry->second.back();
+    update(row);
+    publish(key, row);
+}
+
+//*********************************************************
+// publish()
+//*********************************************************
+void SailingVersions::publish(uint32_t key, Row &row)
+{
+    auto entry = rows.find(key);
+    if (entry == rows.end())
+    {
+        if (!row.live)
+        {
+            return; // Never seen, nothing to delete
+        }
+        entry = rows.emplace(key, vector<Row>()).first;
+    }
+
+    row.version = ++clock;
+    entry->second.push_back(row);
+    if (!prune(entry->second))
+    {
+        rows.erase(entry);
+        stale.erase(key);
+    }
+    else if (entry->second.size() > 1)
+    {
+        stale.insert(key);
+    }
+    else
+    {
+        stale.erase(key);
+    }
+}
+
+//*********************************************************
+// visible()
+//*********************************************************
+const SailingVersions::Row *SailingVersions::visible(
+                                const vector<Row> &versions,
+                                uint64_t version)
+{
+    for (auto row = versions.rbegin(); row != versions.rend();
+            ++row)
+    {
+        if (row->version <= version)
+        {
+            return &*row;
+        }
+    }
+    return nullptr;
+}
+
+//*********************************************************
+// prune()
+// Keeps every version newer than the oldest open snapshot,
+// plus the one that snapshot (or, with none open, any new
+// snapshot) sees
+//*********************************************************
+bool SailingVersions::prune(vector<Row> &versions)
+{
+    uint64_t oldest = snapshots.empty() ? clock
+                                        : *snapshots.begin();
+
+    size_t seen = 0;
+    while (seen + 1 < versions.size()
+            && versions[seen + 1].version <= oldest)
+    {
+        seen++;
+    }
+    versions.erase(versions.begin(), versions.begin() + seen);
+
+    // A deletion every snapshot already sees
+    return !(versions.size() == 1 && !versions[0].live
+             && versions[0].version <= oldest);
+}
@@ -0,0 +1,231 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// SailingVersions.h
+//*********************************************************
+// Purpose: Versioned in-memory occupancy view of every
+// sailing (vessel, vehicles, lane length used, vehicles
+// checked in), so queries and reports read precomputed
+// numbers from a consistent point-in-time snapshot instead
+// of the shared file handles.
+//
+// Every reserve, cancel and check-in applies its change to
+// the sailing's newest row as a delta and publishes the
+// result as a new version, stamped from one version clock.
+// A Snapshot remembers the clock when it was opened and only
+// sees rows stamped at or before it, so a report sees each
+// operation either wholly or not at all, across every page.
+// Older versions are kept only while an open snapshot can
+// still see them.
+//
+// Publishing and reading take one short lock, so a report
+// never holds up bookings for longer than one row. Opening
+// and closing a snapshot cost the same whatever the number
+// of sailings: old versions are pruned as their sailing is
+// next changed, or when the oldest snapshot closes, and then
+// only on sailings changed while it was open.
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, occupancy kept by deltas
+// Oct 17, 2026 Version 3 - Team 18, prune only stale sailings
+// Oct 17, 2026 Version 4 - Team 18, read
+//*********************************************************
+
+#pragma once
+
+#include "Sailing.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class SailingVersions
+{
+public:
+    //*********************************************************
+    // Row
+    //*********************************************************
+    // One version of a sailing's occupancy. Lengths are in
+    // decimetres.
+    //*********************************************************
+    struct Row
+    {
+        // Clock value that made this version current
+        uint64_t version;
+        // false from the version that deleted the sailing on
+        bool live;
+        char vesselName[Sailing::VESSEL_NAME_LENGTH + 1];
+        // Lane lengths of the sailing when empty
+        int HCLL;
+        int LCLL;
+        // Lane length taken by reservations, gaps included
+        int usedHigh;
+        int usedLow;
+        // Reservations on the sailing
+        int vehicles;
+        // Reservations checked in
+        int checkedIn;
+    };
+
+    //*********************************************************
+    // Snapshot
+    //*********************************************************
+    // The table as of the moment the snapshot was opened.
+    // Open for as long as the object lives.
+    //*********************************************************
+    class Snapshot
+    {
+    public:
+        Snapshot();
+        ~Snapshot();
+
+        //*****************************************************
+        // next
+        //*****************************************************
+        // Cursor over the sailings in key order (terminal,
+        // day, hour).
+        // in-out: key - the last key returned, 0 to start;
+        //         set to the key of the row returned
+        // out: row; false when there are no more sailings
+        //*****************************************************
+        bool next(uint32_t &key, Row &row) const;
+
+        //*****************************************************
+        // find
+        //*****************************************************
+        // in: key - encoded sailing ID
+        // out: row; false if the sailing did not exist when
+        // the snapshot was opened
+        //*****************************************************
+        bool find(uint32_t key, Row &row) const;
+
+        Snapshot(const Snapshot &) = delete;
+        Snapshot &operator=(const Snapshot &) = delete;
+
+    private:
+        uint64_t version;
+    };
+
+    //*********************************************************
+    // load
+    //*********************************************************
+    // Fills the view from sailing.dat, the capacity table
+    // and one parallel pass over reservation.dat. Called by
+    // Util::startup once recovery is done.
+    //*********************************************************
+    static void load();
+
+    //*********************************************************
+    // read
+    //*********************************************************
+    // The sailing's newest row, without opening a snapshot;
+    // one row read under the table lock is consistent on its
+    // own.
+    // in: key - encoded sailing ID
+    // out: row; false if the sailing is not in the table
+    //*********************************************************
+    static bool read(uint32_t key, Row &row);
+
+    // The changes below are made by the controls at the end
+    // of each operation, still holding the sailing's stripe.
+    // Lengths are in decimetres. A sailing that is not in the
+    // view is left alone.
+
+    //*********************************************************
+    // addSailing
+    //*********************************************************
+    // in: sailingId, vesselName, HCLL, LCLL
+    //*********************************************************
+    static void addSailing(const string &sailingId,
+                            const string &vesselName,
+                            int HCLL, int LCLL);
+
+    //*********************************************************
+    // removeSailing
+    //*********************************************************
+    // in: sailingId
+    //*********************************************************
+    static void removeSailing(const string &sailingId);
+
+    //*********************************************************
+    // reserve
+    //*********************************************************
+    // Counts a new reservation and the lane it takes.
+    // in: sailingId, highLane, vehicleLength - the gap left
+    //     behind the vehicle is added here
+    //*********************************************************
+    static void reserve(const string &sailingId, bool highLane,
+                        int vehicleLength);
+
+    //*********************************************************
+    // cancel
+    //*********************************************************
+    // Reverses reserve for a cancelled reservation.
+    // in: sailingId, highLane, vehicleLength,
+    //     checkedIn - the reservation had been checked in
+    //*********************************************************
+    static void cancel(const string &sailingId, bool highLane,
+                        int vehicleLength, bool checkedIn);
+
+    //*********************************************************
+    // checkIn
+    //*********************************************************
+    // Counts one more reservation checked in.
+    // in: sailingId
+    //*********************************************************
+    static void checkIn(const string &sailingId);
+
+private:
+    // Guards everything below
+    static mutex tableLock;
+    // Sailing key -> its versions, oldest first
+    static map<uint32_t, vector<Row>> rows;
+    static uint64_t clock;
+    // Versions of the open snapshots
+    static multiset<uint64_t> snapshots;
+    // Keys holding more than one version, the only ones a
+    // closing snapshot can leave anything to prune in
+    static set<uint32_t> stale;
+
+    //*********************************************************
+    // change
+    //*********************************************************
+    // Copies the sailing's newest row, applies update to the
+    // copy and publishes it as a new version.
+    // in: sailingId, update(Row &row)
+    //*********************************************************
+    static void change(const string &sailingId,
+                        function<void(Row &row)> update);
+
+    //*********************************************************
+    // publish
+    //*********************************************************
+    // Stamps a row, adds it as a sailing's newest version and
+    // prunes that sailing's older ones. Called with tableLock
+    // held.
+    // in: key, row
+    //*********************************************************
+    static void publish(uint32_t key, Row &row);
+
+    //*********************************************************
+    // visible
+    //*********************************************************
+    // out: the newest version at or before version, or
+    // nullptr if the sailing did not exist yet
+    //*********************************************************
+    static const Row *visible(const vector<Row> &versions,
+                                uint64_t version);
+
+    //*********************************************************
+    // prune
+    //*********************************************************
+    // Drops versions no open snapshot can see. Called with
+    // tableLock held.
+    // out: false if nothing visible is left and the sailing
+    // can be dropped from the table
+    //*********************************************************
+    static bool prune(vector<Row> &versions);
+};
@@ -0,0 +1,472 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// Server.cpp
+//*********************************************************
+// Purpose: Implements the reservation server. The main
+// thread accepts connections and queues them; a fixed pool
+// of workers serves the queued connections. Requests run
+// in parallel; the controls lock the sailing they work on
+// and the entity classes lock the data files they touch.
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, REPORT_PAGE
+// Oct 17, 2026 Version 3 - Team 18, QUERY_SAILINGS
+// Oct 17, 2026 Version 4 - Team 18, AUDIT
+//*********************************************************
+
+#include "Server.h"
+#include "OtherControls.h"
+#include "SailingControl.h"
+#include "Sailing.h"
+#include "Util.h"
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Longest wait before the accept loop checks for a stop
+static const int STOP_CHECK_MS = 500;
+// Most report lines one REPORT_PAGE request may ask for
+static const int MAX_REPORT_PAGE_ROWS = 1000;
+// Most threads one AUDIT request may ask for
+static const int MAX_AUDIT_WORKERS = 64;
+
+// Set by the signal handler to stop the server
+static volatile sig_atomic_t stopRequested = 0;
+// Set once the accept loop has finished
+static atomic<bool> stopping(false);
+
+// Accepted connections waiting for a worker
+static queue<int> pending;
+// Connections a worker is serving
+static set<int> active;
+// Guards pending and active
+static mutex queueMutex;
+// Signalled when a connection is queued or on stop
+static condition_variable queueReady;
+
+//*********************************************************
+// Signal handler for SIGINT and SIGTERM
+//*********************************************************
+static void onStopSignal(int)
+{
+    stopRequested = 1;
+}
+
+//*********************************************************
+// Writes all of response to the socket
+// out: false if the client has gone away
+//*********************************************************
+static bool sendAll(int fd, const string &response)
+{
+    size_t sent = 0;
+    while (sent < response.size())
+    {
+        ssize_t n = send(fd, response.data() + sent,
+                         response.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        sent += n;
+    }
+    return true;
+}
+
+//*********************************************************
+// Rest of the line after the fields already read, without
+// the separating space
+//*********************************************************
+static string restOfLine(istringstream &fields)
+{
+    string rest;
+    getline(fields >> ws, rest);
+    return rest;
+}
+
+//*********************************************************
+// Departure in dd-hh form, as in a sailing ID
+// in: text
+// out: day, hour; true if text has that form
+//*********************************************************
+static bool parseDeparture(const string &text, int &day, int &hour)
+{
+    if (text.length() != 5 || text[2] != '-')
+    {
+        return false;
+    }
+    for (int i : {0, 1, 3, 4})
+    {
+        if (!isdigit(static_cast<unsigned char>(text[i])))
+        {
+            return false;
+        }
+    }
+    day = (text[0] - '0') * 10 + (text[1] - '0');
+    hour = (text[3] - '0') * 10 + (text[4] - '0');
+    return true;
+}
+
+//*********************************************************
+// run()
+//*********************************************************
+int Server::run(const string &socketPath, int threadCount)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        cout << "Socket path is too long." << endl;
+        return 1;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    // A socket file left by an earlier run would block bind
+    unlink(socketPath.c_str());
+    if (listenFd < 0
+        || bind(listenFd, reinterpret_cast<sockaddr *>(&address),
+                sizeof(address)) < 0
+        || listen(listenFd, SOMAXCONN) < 0)
+    {
+        cout << "Unable to listen on " << socketPath << ": "
+             << strerror(errno) << endl;
+        if (listenFd >= 0)
+        {
+            close(listenFd);
+        }
+        return 1;
+    }
+
+    // Workers never take the stop signals, so they always
+    // interrupt the accept loop in this thread
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    vector<thread> workers;
+    for (int i = 0; i < max(threadCount, 1); i++)
+    {
+        workers.emplace_back(worker);
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onStopSignal;
+    // No SA_RESTART, so poll() returns on a signal
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    pthread_sigmask(SIG_UNBLOCK, &stopSignals, nullptr);
+
+    cout << "Serving on " << socketPath << " with "
+         << workers.size() << " threads." << endl;
+
+    while (!stopRequested)
+    {
+        // Wake up now and then so a signal that lands just
+        // before the wait is still noticed
+        pollfd listening = {listenFd, POLLIN, 0};
+        if (poll(&listening, 1, STOP_CHECK_MS) <= 0)
+        {
+            continue;
+        }
+
+        int clientFd = accept(listenFd, nullptr, nullptr);
+        if (clientFd < 0)
+        {
+            if (errno != EINTR)
+            {
+                cout << "accept failed: " << strerror(errno)
+                     << endl;
+            }
+            continue;
+        }
+
+        lock_guard<mutex> lock(queueMutex);
+        pending.push(clientFd);
+        queueReady.notify_one();
+    }
+
+    cout << "Stopping server..." << endl;
+    close(listenFd);
+    unlink(socketPath.c_str());
+
+    {
+        lock_guard<mutex> lock(queueMutex);
+        stopping = true;
+        // Wake workers blocked reading from a client
+        for (int clientFd : active)
+        {
+            shutdown(clientFd, SHUT_RDWR);
+        }
+        while (!pending.empty())
+        {
+            close(pending.front());
+            pending.pop();
+        }
+    }
+    queueReady.notify_all();
+
+    for (thread &w : workers)
+    {
+        w.join();
+    }
+
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    return 0;
+}
+
+//*********************************************************
+// worker()
+//*********************************************************
+void Server::worker()
+{
+    while (true)
+    {
+        int clientFd;
+        {
+            unique_lock<mutex> lock(queueMutex);
+            queueReady.wait(lock, []()
+            {
+                return stopping || !pending.empty();
+            });
+            if (stopping)
+            {
+                return;
+            }
+            clientFd = pending.front();
+            pending.pop();
+            active.insert(clientFd);
+        }
+
+        serveClient(clientFd);
+
+        {
+            lock_guard<mutex> lock(queueMutex);
+            active.erase(clientFd);
+        }
+        close(clientFd);
+    }
+}
+
+//*********************************************************
+// serveClient()
+//*********************************************************
+void Server::serveClient(int clientFd)
+{
+    string received;
+    char buffer[4096];
+
+    while (!stopping)
+    {
+        size_t newline = received.find('\n');
+        if (newline == string::npos)
+        {
+            ssize_t n = recv(clientFd, buffer, sizeof(buffer), 0);
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                return; // Client disconnected
+            }
+            received.append(buffer, n);
+            continue;
+        }
+
+        string line = received.substr(0, newline);
+        received.erase(0, newline + 1);
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+
+        string response = handleRequest(line);
+        if (response.empty() || !sendAll(clientFd, response))
+        {
+            return; // QUIT, or the client went away
+        }
+    }
+}
+
+//*********************************************************
+// handleRequest()
+//*********************************************************
+string Server::handleRequest(const string &line)
+{
+    istringstream fields(line);
+    string command;
+    fields >> command;
+
+    if (command == "QUIT")
+    {
+        return "";
+    }
+    if (command.empty())
+    {
+        return "ERR empty request\n";
+    }
+
+    ostringstream out;
+    bool ok = false;
+    bool known = true;
+
+    if (command == "CREATE_RESERVATION")
+    {
+        string phone, sailingId, license;
+        // Dimensions arrive in metres
+        double height = Util::toMetres(REGULAR_VEHICLE_HEIGHT);
+        double length = Util::toMetres(REGULAR_VEHICLE_LENGTH);
+        fields >> phone >> sailingId >> license;
+        // The dimensions are optional, but once given both
+        // must be numbers; a vehicle sized by default could
+        // be booked into the wrong lane
+        bool sized = !(fields >> ws).eof();
+        if (sized)
+        {
+            fields >> height >> length;
+        }
+        ok = !license.empty() && !(sized && fields.fail())
+            && OtherControls::createReservation(phone, sailingId,
+                                license, Util::toDecimetres(height),
+                                Util::toDecimetres(length));
+    }
+    else if (command == "DELETE_RESERVATION")
+    {
+        string license, sailingId;
+        fields >> license >> sailingId;
+        ok = !sailingId.empty()
+            && OtherControls::deleteReservation(license,
+                                                sailingId);
+    }
+    else if (command == "CHECK_IN")
+    {
+        string license, sailingId;
+        fields >> license >> sailingId;
+        ok = !sailingId.empty()
+            && OtherControls::checkIn(license, sailingId);
+    }
+    else if (command == "CREATE_VESSEL")
+    {
+        int HCLL = -1, LCLL = -1;
+        fields >> HCLL >> LCLL;
+        string vesselName = restOfLine(fields);
+        ok = !vesselName.empty()
+            && OtherControls::createVessel(vesselName, HCLL, LCLL);
+    }
+    else if (command == "CREATE_SAILING")
+    {
+        string sailingId;
+        fields >> sailingId;
+        string vesselName = restOfLine(fields);
+        ok = !vesselName.empty()
+            && SailingControl::createSailing(sailingId,
+                                            vesselName);
+    }
+    else if (command == "DELETE_SAILING")
+    {
+        string sailingId;
+        fields >> sailingId;
+        ok = SailingControl::deleteSailing(sailingId, true);
+    }
+    else if (command == "QUERY_SAILING")
+    {
+        string sailingId;
+        fields >> sailingId;
+        ok = SailingControl::querySailing(sailingId, out);
+    }
+    else if (command == "QUERY_SAILINGS")
+    {
+        SailingControl::Filter filter;
+        string terminal, from, to;
+        fields >> terminal >> from >> to;
+        if (terminal != "*")
+        {
+            filter.terminal = terminal;
+        }
+        double percent;
+        if (fields >> percent)
+        {
+            filter.overPercentFull = percent;
+        }
+        ok = !to.empty()
+            && parseDeparture(from, filter.fromDay, filter.fromHour)
+            && parseDeparture(to, filter.toDay, filter.toHour)
+            && SailingControl::querySailings(filter, out);
+    }
+    else if (command == "REPORT")
+    {
+        SailingControl::printSailingReport(out);
+        ok = true;
+    }
+    else if (command == "REPORT_PAGE")
+    {
+        int rows = 0;
+        string cursor;
+        fields >> rows >> cursor;
+        ok = rows > 0 && rows <= MAX_REPORT_PAGE_ROWS
+            && (cursor.empty() || Sailing::isValidSailingId(cursor));
+        if (ok && SailingControl::printReportPage(out, cursor, rows))
+        {
+            out << "NEXT " << cursor << "\n";
+        }
+    }
+    else if (command == "AUDIT")
+    {
+        int workers = max(1u, thread::hardware_concurrency());
+        fields >> workers;
+        ok = workers > 0 && workers <= MAX_AUDIT_WORKERS;
+        if (ok)
+        {
+            SailingControl::printAuditReport(out, workers);
+        }
+    }
+    else if (command == "COMPACT")
+    {
+        out << Sailing::compactRecords() << "\n";
+        ok = true;
+    }
+    else
+    {
+        known = false;
+    }
+
+    if (!known)
+    {
+        return "ERR unknown command " + command + "\n";
+    }
+    if (!ok)
+    {
+        return out.str() + "ERR " + command + " failed\n";
+    }
+    string data = out.str();
+    if (!data.empty() && data.back() != '\n')
+    {
+        data += '\n';
+    }
+    return data + "OK\n";
+}
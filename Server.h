@@ -0,0 +1,103 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// Server.h
+//*********************************************************
+// Purpose: Reservation server. Serves the OtherControls and
+// SailingControl operations to local clients (booking
+// agents, check-in kiosks) over a Unix domain socket, so
+// they all share one process and one in-memory state
+// instead of each running its own copy on the .dat files.
+// Connections are handed to a fixed pool of worker threads.
+//
+// Protocol: one request per line, fields separated by
+// spaces. A request is answered by zero or more data lines
+// followed by a line "OK" or "ERR <reason>".
+//   CREATE_RESERVATION phone sailingId license
+//                      [height length]
+//   DELETE_RESERVATION license sailingId
+//   CHECK_IN license sailingId
+//   CREATE_VESSEL HCLL LCLL vessel name
+//   CREATE_SAILING sailingId vessel name
+//   DELETE_SAILING sailingId
+//   QUERY_SAILING sailingId
+//   QUERY_SAILINGS terminal from to [percent]
+//   REPORT
+//   REPORT_PAGE rows [cursor]
+//   AUDIT [threads]
+//   COMPACT
+//   QUIT
+// Names may contain spaces, so they are always last.
+// COMPACT drops deleted sailings from sailing.dat and
+// answers with the number reclaimed.
+// REPORT_PAGE answers with up to rows report lines (at most
+// 1000) after the sailing ID cursor, or from the start
+// without one. If more sailings follow, the last data line
+// is "NEXT <cursor>" to send with the next request.
+// QUERY_SAILINGS answers with the report lines of the
+// sailings of terminal (* for every terminal) departing from
+// one dd-hh to another, both included, and if percent is
+// given only those more than percent full.
+// AUDIT answers with the sailing report recounted from the
+// data files, read by threads threads (at most 64, one per
+// core by default). The server's changes to the data files
+// wait until it is done (see
+// SailingControl::printAuditReport).
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, COMPACT
+// Oct 17, 2026 Version 3 - Team 18, REPORT_PAGE
+// Oct 17, 2026 Version 4 - Team 18, QUERY_SAILINGS
+// Oct 17, 2026 Version 5 - Team 18, AUDIT
+//*********************************************************
+
+#pragma once
+
+#include <string>
+
+using namespace std;
+
+class Server
+{
+public:
+    // Worker threads used when none are requested
+    static const int DEFAULT_THREADS = 4;
+
+    //*********************************************************
+    // run
+    //*********************************************************
+    // Listens on socketPath and serves clients until SIGINT
+    // or SIGTERM. The data files must already be open
+    // (Util::startup).
+    // in: socketPath - file system path of the socket
+    //     threadCount - number of worker threads
+    // out: 0 on a clean stop, 1 if the socket failed
+    //*********************************************************
+    static int run(const string &socketPath, int threadCount);
+
+private:
+    //*********************************************************
+    // worker
+    //*********************************************************
+    // Takes accepted connections off the queue and serves
+    // them one at a time until the server stops.
+    //*********************************************************
+    static void worker();
+
+    //*********************************************************
+    // serveClient
+    //*********************************************************
+    // Reads request lines from one connection and writes the
+    // responses until the client quits or disconnects.
+    // in: clientFd - connected socket
+    //*********************************************************
+    static void serveClient(int clientFd);
+
+    //*********************************************************
+    // handleRequest
+    //*********************************************************
+    // Runs one request line.
+    // in: line - request without its newline
+    // out: response, ending in "OK\n" or "ERR ...\n"; empty
+    // for QUIT
+    //*********************************************************
+    static string handleRequest(const string &line);
+};
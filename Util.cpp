@@ -5,12 +5,32 @@
 // Purpose: Provides system-level helper functions such as
 // startup, shutdown, and reset operations.
 // July 20, 2025 Version 1 - Darpandeep Kaur
+// Oct 17, 2026 Version 2 - Team 18, file locks and sailing
+// lock stripes
+// Oct 17, 2026 Version 3 - Team 18, decimetre conversions
+// Oct 17, 2026 Version 4 - Team 18, write-ahead log
+// Oct 17, 2026 Version 5 - Team 18, lanes rebuilt after a
+// crash
+// Oct 17, 2026 Version 6 - Team 18, versioned sailing table
+// Oct 17, 2026 Version 7 - Team 18, vehicle lock stripes
+// Oct 17, 2026 Version 8 - Team 18, data file locks guard
+// their byte-range locks
+// Oct 17, 2026 Version 9 - Team 18, log closed before the
+// indexes
 //*********************************************************
 
 #include "Util.h"
+#include "Sailing.h"
+#include "Vehicle.h"
+#include "Reservation.h"
+#include "Vessel.h"
+#include "WriteAheadLog.h"
+#include "SailingVersions.h"
 
 #include <iostream>
 #include <cstdio> 
+#include <cmath>
+#include <filesystem>
 using namespace std;
 
 fstream Util::vesselFile;
@@ -18,6 +38,18 @@ fstream Util::sailingFile;
 fstream Util::reservationFile;
 fstream Util::vehicleFile;
 
+FileLock Util::vesselFileLock(&Util::vesselLock);
+FileLock Util::sailingFileLock(&Util::sailingLock);
+FileLock Util::reservationFileLock(&Util::reservationLock);
+FileLock Util::vehicleFileLock(&Util::vehicleLock);
+
+OwnedMutex Util::vesselLock;
+OwnedMutex Util::sailingLock;
+OwnedMutex Util::reservationLock;
+OwnedMutex Util::vehicleLock;
+mutex Util::sailingStripes[SAILING_STRIPES];
+mutex Util::vehicleStripes[VEHICLE_STRIPES];
+
 //*********************************************************
 // Default Constructor
 //*********************************************************
@@ -115,6 +147,39 @@ void Util::startup()
                                       | ios::binary); 
     }
 
+    // Open the byte-range locks shared with other processes
+    vesselFileLock.open("vessel.dat");
+    sailingFileLock.open("sailing.dat");
+    reservationFileLock.open("reservation.dat");
+    vehicleFileLock.open("vehicle.dat");
+
+    // Load the vessel catalog
+    Vessel::loadCatalog();
+
+    // Open (or rebuild) the on-disk indexes
+    Sailing::openIndex();
+    Vehicle::openIndex();
+    Reservation::openIndex();
+
+    // After a crash, sailing.dat and reservation.dat may
+    // disagree over an operation that was cut short, so the
+    // lanes are recomputed from the reservations first. The
+    // logged operations are then replayed on top.
+    WriteAheadLog::open("ferry.wal");
+    if (WriteAheadLog::wasLeftOpen())
+    {
+        int corrected = Sailing::rebuildCapacity();
+        if (corrected > 0)
+        {
+            cout << "Corrected the lanes of " << corrected
+                << " sailings." << endl;
+        }
+    }
+    WriteAheadLog::recover();
+
+    // The table reports read their snapshots from
+    SailingVersions::load();
+
     cout << "Startup complete." << endl;
 }
 
@@ -125,6 +190,16 @@ void Util::shutdown()
 {
     cout << "Shutting down the system..." << endl;
 
+    // Sync the data files and empty the log. This first
+    // stops the log's watcher, which writes back lanes
+    // through the sailing index
+    WriteAheadLog::close();
+
+    // Close the on-disk indexes
+    Sailing::closeIndex();
+    Vehicle::closeIndex();
+    Reservation::closeIndex();
+
     if (vesselFile.is_open())
     {
         // Close vessel file only if it is open
@@ -148,6 +223,12 @@ void Util::shutdown()
         // Close vehicle file only if it is open
         vehicleFile.close(); 
     }
+
+    // Release any byte-range locks still held
+    vesselFileLock.close();
+    sailingFileLock.close();
+    reservationFileLock.close();
+    vehicleFileLock.close();
     cout << "Shutdown complete." << endl;
 }
 
@@ -187,37 +268,86 @@ void Util::reset()
     cout << "System data reset compelete." << endl;
 }
 
+//*********************************************************
+// Shrinks a file in place to newSize bytes. Nothing is
+// copied, so the cost does not depend on the file size.
+//*********************************************************
 bool Util::truncate(const std::string& filename, 
                     std::streamoff newSize)
 {
-    std::fstream file(filename, std::ios::in 
-                              | std::ios::out 
-                              | std::ios::binary);
-    if (!file)
+    std::error_code error;
+    std::filesystem::resize_file(filename, newSize, error);
+    if (error)
     {
-        std::cerr << "Failed to open file: " 
+        std::cerr << "Failed to truncate file: " 
                     << filename << std::endl;
         return false;
     }
 
-    // Read only up to newSize bytes
-    std::string buffer(newSize, '\0');
-    file.read(&buffer[0], newSize);
-    file.close();
+    return true;
+}
 
-    // Overwrite file with only the portion we want 
-    std::ofstream out(filename, std::ios::binary 
-                              | std::ios::trunc);
-    if (!out)
-    {
-        std::cerr << "Failed to truncate file: " 
-                    << filename << std::endl;
-        return false;
-    }
+//*********************************************************
+// Shrinks a file that is currently open through file.
+// Pending writes are flushed first, and the stream is left
+// open; the caller's next seek discards anything buffered
+// from the old end of the file.
+//*********************************************************
+bool Util::truncate(std::fstream &file, 
+                    const std::string &filename, 
+                    std::streamoff newSize)
+{
+    file.clear();
+    file.flush();
 
-    out.write(buffer.c_str(), newSize);
-    out.close();
+    bool truncated = truncate(filename, newSize);
 
-    return true;
+    file.clear();
+    file.seekg(0, std::ios::beg);
+    file.seekp(0, std::ios::beg);
+    return truncated;
+}
+
+//*********************************************************
+// sailingStripe
+// Picks the stripe for a sailing ID by hash
+// in: sailingId
+// out: the stripe's mutex
+//*********************************************************
+mutex &Util::sailingStripe(const string &sailingId)
+{
+    return sailingStripes[hash<string>()(sailingId) 
+                            % SAILING_STRIPES];
 }
 
+//*********************************************************
+// vehicleStripe
+// Picks the stripe for a license plate by hash
+// in: license
+// out: the stripe's mutex
+//*********************************************************
+mutex &Util::vehicleStripe(const string &license)
+{
+    return vehicleStripes[hash<string>()(license) 
+                            % VEHICLE_STRIPES];
+}
+
+//*********************************************************
+// toDecimetres
+// in: metres
+// out: metres rounded to whole decimetres
+//*********************************************************
+int Util::toDecimetres(double metres)
+{
+    return static_cast<int>(lround(metres * DECIMETRES_PER_METRE));
+}
+
+//*********************************************************
+// toMetres
+// in: decimetres
+// out: the same length in metres
+//*********************************************************
+double Util::toMetres(int decimetres)
+{
+    return static_cast<double>(decimetres) / DECIMETRES_PER_METRE;
+}
@@ -5,11 +5,19 @@
 // Purpose: Provides system-level helper functions such as
 // startup, shutdown, and reset operations.
 // July 20, 2025 Version 2 - All team members
+// Oct 17, 2026 Version 3 - Team 18, file locks and sailing
+// lock stripes for concurrent callers
+// Oct 17, 2026 Version 4 - Team 18, decimetre conversions
+// Oct 17, 2026 Version 5 - Team 18, vehicle lock stripes
+// Oct 17, 2026 Version 6 - Team 18, data file locks guard
+// their byte-range locks
 //*********************************************************
 
 #pragma once
 
+#include "FileLock.h"
 #include <fstream>
+#include <mutex>
 #include <string>
 
 class Util
@@ -24,12 +32,69 @@ public:
     static void shutdown(); 
     // Resets system data (e.g., clears files)
     static void reset();    
+    // Shrinks a file in place to newSize bytes. Callers hold
+    // the whole-file lock (RecordFile's compaction paths do)
     static bool truncate(const std::string &filename, 
                             std::streamoff newSize);
+    // Shrinks a file that is open through file, keeping the
+    // stream open and usable
+    static bool truncate(std::fstream &file, 
+                            const std::string &filename, 
+                            std::streamoff newSize);
+
+    // Lane and vehicle lengths are kept as whole decimetres
+    // in the records and in memory; metres are only used at
+    // the UI, so comparisons and sums are exact
+    static const int DECIMETRES_PER_METRE = 10;
+    // Rounds metres to the nearest decimetre
+    static int toDecimetres(double metres);
+    // Converts decimetres back to metres for display
+    static double toMetres(int decimetres);
 
     // Shared static file handles
     static std::fstream vesselFile;
     static std::fstream sailingFile;
     static std::fstream reservationFile;
     static std::fstream vehicleFile;
+
+    // Byte-range locks on the same files, shared with other
+    // ferry processes; each is guarded by the file's lock
+    // below
+    static FileLock vesselFileLock;
+    static FileLock sailingFileLock;
+    static FileLock reservationFileLock;
+    static FileLock vehicleFileLock;
+
+    // One lock per data file, held by the entity classes for
+    // each operation on the file and its in-memory state.
+    // Recursive, since operations call one another.
+    // Lock order: a sailing stripe first, then a vehicle
+    // stripe, then vessel, sailing, reservation, vehicle.
+    static OwnedMutex vesselLock;
+    static OwnedMutex sailingLock;
+    static OwnedMutex reservationLock;
+    static OwnedMutex vehicleLock;
+
+    // Number of sailing lock stripes
+    static const int SAILING_STRIPES = 64;
+
+    // Lock for the stripe a sailing ID hashes to. The controls
+    // hold it across a whole operation on one sailing, so
+    // bookings on the same sailing are serialized while
+    // bookings on other sailings run in parallel.
+    static std::mutex &sailingStripe(const std::string &sailingId);
+
+    // Number of vehicle lock stripes
+    static const int VEHICLE_STRIPES = 64;
+
+    // Lock for the stripe a license plate hashes to, taken
+    // after the sailing stripe. A booking holds it from
+    // finding the vehicle unknown until it is written, so two
+    // bookings cannot both add the same vehicle, without
+    // holding vehicleLock while the booking is logged.
+    static std::mutex &vehicleStripe(const std::string &license);
+
+private:
+    static std::mutex sailingStripes[SAILING_STRIPES];
+    static std::mutex vehicleStripes[VEHICLE_STRIPES];
 };
@@ -6,6 +6,7 @@
 // license, phone, height, and length data. Used in
 // reservations.
 // July 20, 2025 Version 2 - Darpandeep Kaur
+// Oct 17, 2026 Version 3 - Team 18, sizes in whole decimetres
 //*********************************************************
 
 #include "Vehicle.h"
@@ -19,6 +20,14 @@
 
 using namespace std;
 
+//************************************************************
+// Index of license -> slot, backed by vehicle.idx
+//************************************************************
+HashIndex Vehicle::index("vehicle.idx", VehicleKey::LENGTH);
+RecordFile<Vehicle, VehicleKey> Vehicle::records(
+                        Util::vehicleFile, Util::vehicleFileLock,
+                        "vehicle.dat", &index);
+
 //************************************************************
 // Default Constructor
 // Initializes a vehicle with default values.
@@ -41,7 +50,7 @@ Vehicle::Vehicle()
 // in: license, phone, height, length
 //************************************************************
 Vehicle::Vehicle(const string &license, const string &phone, 
-                float height, float length)
+                int height, int length)
 {
     // Set license from input
     strncpy(this->license, license.c_str(), 
@@ -74,10 +83,10 @@ void Vehicle::writeToFile(fstream &file) const
         file.write(phone, PHONE_LENGTH + 1); 
         // Write height to file
         file.write(reinterpret_cast<const char *>(&height), 
-                        sizeof(float)); 
+                        sizeof(int)); 
         // Write length to file
         file.write(reinterpret_cast<const char *>(&length), 
-                        sizeof(float)); 
+                        sizeof(int)); 
     }
     else
     {
@@ -108,6 +117,44 @@ void Vehicle::readFromFile(fstream &file)
     }
 }
 
+//************************************************************
+// Copies the fields out of a record in file layout.
+// in: record - RECORD_SIZE bytes
+//************************************************************
+void Vehicle::readFromBuffer(const char *record)
+{
+    // Copy license string
+    memcpy(license, record, LICENSE_PLATE_LENGTH + 1); 
+    record += LICENSE_PLATE_LENGTH + 1; 
+    // Copy phone string
+    memcpy(phone, record, PHONE_LENGTH + 1); 
+    record += PHONE_LENGTH + 1; 
+    // Copy height
+    memcpy(&height, record, sizeof(height)); 
+    record += sizeof(height); 
+    // Copy length
+    memcpy(&length, record, sizeof(length)); 
+}
+
+//************************************************************
+// Copies the fields into a record in file layout.
+// out: record - RECORD_SIZE bytes
+//************************************************************
+void Vehicle::writeToBuffer(char *record) const
+{
+    // Copy license string
+    memcpy(record, license, LICENSE_PLATE_LENGTH + 1); 
+    record += LICENSE_PLATE_LENGTH + 1; 
+    // Copy phone string
+    memcpy(record, phone, PHONE_LENGTH + 1); 
+    record += PHONE_LENGTH + 1; 
+    // Copy height
+    memcpy(record, &height, sizeof(height)); 
+    record += sizeof(height); 
+    // Copy length
+    memcpy(record, &length, sizeof(length)); 
+}
+
 //************************************************************
 // Checks if a vehicle with a given license exists in the file.
 // in: license
@@ -115,31 +162,14 @@ void Vehicle::readFromFile(fstream &file)
 //************************************************************
 bool Vehicle::checkExist(const string &license)
 {
+    lock_guard<OwnedMutex> lock(Util::vehicleLock);
     // Check if the vehicle file is open
     if (Util::vehicleFile.is_open()) 
     {
-        // Clear any error flags
-        Util::vehicleFile.clear(); 
-        // Move to the beginning of the file
-        Util::vehicleFile.seekg(0, ios::beg); 
-
-        // Create a Vehicle instance to read records
+        // Create a Vehicle instance to hold the record
         Vehicle vehicle; 
-        // Loop until end of file
-        while (!Util::vehicleFile.eof()) 
-        {
-            // Read a vehicle record
-            vehicle.readFromFile(Util::vehicleFile); 
-
-            // Check if the license matches
-            if (strcmp(vehicle.license, license.c_str()) == 0) 
-            {
-                // Vehicle found, return true
-                return true; 
-            }
-        }
-        // Not found, safe to create new vehicle
-        return false; 
+        // Look the license up through the index
+        return find(license, vehicle); 
     }
     else
     {
@@ -150,6 +180,23 @@ bool Vehicle::checkExist(const string &license)
     }
 }
 
+//************************************************************
+// Looks a vehicle up by license through the index and reads
+// the record at its slot.
+// in: license
+// out: fills foundVehicle and returns true if found
+//************************************************************
+bool Vehicle::find(const string &license, Vehicle &foundVehicle)
+{
+    lock_guard<OwnedMutex> lock(Util::vehicleLock);
+    // Build the index key for this license
+    char key[VehicleKey::LENGTH]; 
+    makeKey(license, key); 
+
+    // Read the record the index points to
+    return records.find(key, foundVehicle) >= 0; 
+}
+
 //************************************************************
 // Writes a new vehicle record to the file if it doesn't exist.
 // in: license, phone, height, length
@@ -157,21 +204,45 @@ bool Vehicle::checkExist(const string &license)
 //************************************************************
 bool Vehicle::writeVehicle(const string &license, 
                            const string &phone, 
-                           float height, 
-                           float length)
+                           int height, 
+                           int length)
 {
+    lock_guard<OwnedMutex> lock(Util::vehicleLock);
     // Create a Vehicle instance with provided values
     Vehicle vehicle(license, phone, height, length); 
-    // Clear any error flags
-    Util::vehicleFile.clear(); 
-    // Move to the end of the file
-    Util::vehicleFile.seekp(0, ios::end); 
-    // Write the vehicle record to the file
-    vehicle.writeToFile(Util::vehicleFile); 
-    // Flush the file to ensure data is written
-    Util::vehicleFile.flush(); 
-    // Return true indicating success
-    return true; 
+    // Append the record and index its slot
+    return records.append(vehicle) >= 0; 
+}
+
+//************************************************************
+// Copies the license into a zero-padded key buffer so every
+// key has the same length on disk.
+// in: license
+// out: key
+//************************************************************
+void Vehicle::makeKey(const string &license, char *key)
+{
+    memset(key, 0, VehicleKey::LENGTH); 
+    strncpy(key, license.c_str(), LICENSE_PLATE_LENGTH); 
+}
+
+//************************************************************
+// Opens vehicle.idx and rebuilds it when its entry count does
+// not match the number of records in vehicle.dat.
+//************************************************************
+void Vehicle::openIndex()
+{
+    lock_guard<OwnedMutex> lock(Util::vehicleLock);
+    records.openIndex(); 
+}
+
+//************************************************************
+// Closes vehicle.idx.
+//************************************************************
+void Vehicle::closeIndex()
+{
+    lock_guard<OwnedMutex> lock(Util::vehicleLock);
+    records.closeIndex(); 
 }
 
 //************************************************************
@@ -185,8 +256,8 @@ string Vehicle::toString() const
     // Format the string with vehicle details
     ss << "License: " << license 
        << ", Phone: " << phone
-       << ", Height: " << height
-       << "m, Length: " << length << "m";
+       << ", Height: " << Util::toMetres(height)
+       << "m, Length: " << Util::toMetres(length) << "m";
     // Return the formatted string
     return ss.str(); 
 }
@@ -202,26 +273,17 @@ string Vehicle::toString() const
 //************************************************************
 string Vehicle::getLicense(string license) const
 {
-    // Clear any error flags
-    Util::vehicleFile.clear(); 
-    // Move to the beginning of the file
-    Util::vehicleFile.seekg(0, ios::beg); 
-
-    // Create a Vehicle instance to read records
+    lock_guard<OwnedMutex> lock(Util::vehicleLock);
+    // Create a Vehicle instance to hold the record
     Vehicle vehicle; 
-    // Loop through records
-    while (Util::vehicleFile.read(reinterpret_cast
-            <char *>(&vehicle), RECORD_SIZE)) 
+    // Look the license up through the index
+    if (find(license, vehicle)) 
     {
-        // Check if the license matches
-        if (strcmp(vehicle.license, license.c_str()) == 0) 
-        {
-            // Output found message
-            cout << "License: " << license << " found." 
-                << endl; 
-            // Return the matching license
-            return license; 
-        }
+        // Output found message
+        cout << "License: " << license << " found." 
+            << endl; 
+        // Return the matching license
+        return license; 
     }
     // Output not found message
     cout << "License: " << license << " not found." 
@@ -233,10 +295,11 @@ string Vehicle::getLicense(string license) const
 //************************************************************
 // Gets the height of a vehicle with a given license.
 // in: license
-// out: height (rounded to 2 decimal places), or -1 if not found
+// out: height in decimetres, or -1 if not found
 //************************************************************
-float Vehicle::getHeight(string license)
+int Vehicle::getHeight(string license)
 {
+    lock_guard<OwnedMutex> lock(Util::vehicleLock);
     // Check if the vehicle file is open
     if (!Util::vehicleFile.is_open()) 
     {
@@ -246,25 +309,14 @@ float Vehicle::getHeight(string license)
         return -1; 
     }
 
-    // Clear any error flags
-    Util::vehicleFile.clear(); 
-    // Move to the beginning of the file
-    Util::vehicleFile.seekg(0, ios::beg); 
-
-    // Create a Vehicle instance to read records
+    // Create a Vehicle instance to hold the record
     Vehicle vehicle; 
 
-    // Loop until end of file
-    while (!Util::vehicleFile.eof()) 
+    // Look the license up through the index
+    if (find(license, vehicle)) 
     {
-        // Read a vehicle record
-        vehicle.readFromFile(Util::vehicleFile); 
-        // Check if the license matches
-        if (strcmp(vehicle.license, license.c_str()) == 0) 
-        {
-            // Return the height if found
-            return vehicle.height; 
-        }
+        // Return the height if found
+        return vehicle.height; 
     }
 
     // Output not found message
@@ -277,10 +329,11 @@ float Vehicle::getHeight(string license)
 //************************************************************
 // Gets the length of a vehicle with a given license.
 // in: license
-// out: length (rounded to 2 decimal places), or -1 if not found
+// out: length in decimetres, or -1 if not found
 //************************************************************
-float Vehicle::getLength(string license)
+int Vehicle::getLength(string license)
 {
+    lock_guard<OwnedMutex> lock(Util::vehicleLock);
     // Check if the vehicle file is open
     if (!Util::vehicleFile.is_open()) 
     {
@@ -289,25 +342,14 @@ float Vehicle::getLength(string license)
         return -1; // Return -1 to indicate error
     }
 
-    // Clear any error flags
-    Util::vehicleFile.clear(); 
-    // Move to the beginning of the file
-    Util::vehicleFile.seekg(0, ios::beg); 
-
-    // Create a Vehicle instance to read records
+    // Create a Vehicle instance to hold the record
     Vehicle vehicle; 
 
-    // Loop until end of file
-    while (!Util::vehicleFile.eof()) 
+    // Look the license up through the index
+    if (find(license, vehicle)) 
     {
-        // Read a vehicle record
-        vehicle.readFromFile(Util::vehicleFile); 
-        // Check if the license matches
-        if (strcmp(vehicle.license, license.c_str()) == 0) 
-        {
-            // Return the length if found
-            return vehicle.length; 
-        }
+        // Return the length if found
+        return vehicle.length; 
     }
 
     // Output not found message
@@ -338,7 +380,7 @@ void Vehicle::setLicense(string license)
 // Sets the vehicle height.
 // in: height
 //************************************************************
-void Vehicle::setHeight(float height)
+void Vehicle::setHeight(int height)
 {
     // Set height from input
     this->height = height; 
@@ -348,7 +390,7 @@ void Vehicle::setHeight(float height)
 // Sets the vehicle length.
 // in: length
 //************************************************************
-void Vehicle::setLength(float length)
+void Vehicle::setLength(int length)
 {
     // Set length from input
     this->length = length; 
@@ -6,19 +6,26 @@
 // license, phone, height, and length data. Used in
 // reservations.
 // July 20, 2025 Version 3 - All team members
+// Oct 17, 2026 Version 4 - Team 18, license lookups go
+// through a persistent hash index (vehicle.idx)
+// Oct 17, 2026 Version 5 - Team 18, sizes in whole decimetres
 //*********************************************************
 
 #pragma once
 
+#include "HashIndex.h"
+#include "RecordFile.h"
 #include <string>
 #include <fstream>
 
 using namespace std;
 
-// Maximum height for regular vehicles
-static const float REGULAR_VEHICLE_HEIGHT = 2.0; 
-// Maximum length for regular vehicles
-static const float REGULAR_VEHICLE_LENGTH = 7.0; 
+struct VehicleKey;
+
+// Maximum height for regular vehicles (2.0 m) in decimetres
+static const int REGULAR_VEHICLE_HEIGHT = 20; 
+// Maximum length for regular vehicles (7.0 m) in decimetres
+static const int REGULAR_VEHICLE_LENGTH = 70; 
 // Maximum length for vehicle license plates
 static const int LICENSE_PLATE_LENGTH = 10; 
 // Maximum length for phone numbers
@@ -31,20 +38,21 @@ public:
     // RECORD_SIZE
     //*********************************************************
     // Total size of a vehicle record in bytes: 
-    // license + phone + height + length
+    // license + phone (each with null terminator) + height
+    // + length
     //*********************************************************
-    static const int RECORD_SIZE = LICENSE_PLATE_LENGTH 
-                                + PHONE_LENGTH 
-                                + sizeof(float) * 2;
+    static const int RECORD_SIZE = LICENSE_PLATE_LENGTH + 1
+                                + PHONE_LENGTH + 1
+                                + sizeof(int) * 2;
 
     // Array to store vehicle license, +1 for null terminator
     char license[LICENSE_PLATE_LENGTH + 1]; 
     // Array to store phone number, +1 for null terminator
     char phone[PHONE_LENGTH + 1];      
-    // Height of the vehicle     
-    float height; 
-    // Length of the vehicle
-    float length; 
+    // Height of the vehicle in decimetres
+    int height; 
+    // Length of the vehicle in decimetres
+    int length; 
 
     //*********************************************************
     // Default Constructor
@@ -58,7 +66,7 @@ public:
     // in: license, phone, height, length
     //*********************************************************
     Vehicle(const string &license, const string &phone, 
-            float height, float length);
+            int height, int length);
 
     //*********************************************************
     // writeToFile
@@ -76,6 +84,23 @@ public:
     //*********************************************************
     void readFromFile(fstream &file);
 
+    //*********************************************************
+    // readFromBuffer
+    //*********************************************************
+    // Fills this vehicle from a record held in memory, e.g. a
+    // record handed out by RecordScanner.
+    // in: record - RECORD_SIZE bytes in file layout
+    //*********************************************************
+    void readFromBuffer(const char *record);
+
+    //*********************************************************
+    // writeToBuffer
+    //*********************************************************
+    // Stores this vehicle in file layout.
+    // out: record - RECORD_SIZE bytes
+    //*********************************************************
+    void writeToBuffer(char *record) const;
+
     //*********************************************************
     // getLicense
     //*********************************************************
@@ -90,20 +115,18 @@ public:
     //*********************************************************
     // Gets the height of a vehicle with a given license.
     // in: license
-    // out: height (rounded to 2 decimal places), or -1 if not
-    // found
+    // out: height in decimetres, or -1 if not found
     //*********************************************************
-    static float getHeight(const string license);
+    static int getHeight(const string license);
 
     //*********************************************************
     // getLength
     //*********************************************************
     // Gets the length of a vehicle with a given license.
     // in: license
-    // out: length (rounded to 2 decimal places), or -1 if not
-    // found
+    // out: length in decimetres, or -1 if not found
     //*********************************************************
-    static float getLength(const string license);
+    static int getLength(const string license);
 
     //*********************************************************
     // setLicense
@@ -117,17 +140,17 @@ public:
     // setHeight
     //*********************************************************
     // Sets the vehicle height.
-    // in: height
+    // in: height - in decimetres
     //*********************************************************
-    void setHeight(float height);
+    void setHeight(int height);
 
     //*********************************************************
     // setLength
     //*********************************************************
     // Sets the vehicle length.
-    // in: length
+    // in: length - in decimetres
     //*********************************************************
-    void setLength(float length);
+    void setLength(int length);
 
     //*********************************************************
     // checkExist
@@ -139,17 +162,28 @@ public:
     //*********************************************************
     static bool checkExist(const string &license);
 
+    //*********************************************************
+    // find
+    //*********************************************************
+    // Looks a vehicle up by license and reads its whole
+    // record with one index lookup.
+    // in: license
+    // out: foundVehicle (by reference), true if found
+    //*********************************************************
+    static bool find(const string &license, 
+                    Vehicle &foundVehicle);
+
     //*********************************************************
     // writeVehicle
     //*********************************************************
     // Writes a new vehicle record to the file if it doesn't
     // exist.
-    // in: license, phone, height, length
+    // in: license, phone, height, length - in decimetres
     // out: true if successfully written, false otherwise
     //*********************************************************
     static bool writeVehicle(const string &license, 
                             const string &phone, 
-                            float height, float length);
+                            int height, int length);
 
     //*********************************************************
     // toString
@@ -158,4 +192,50 @@ public:
     // out: formatted string
     //*********************************************************
     string toString() const;
-};
\ No newline at end of file
+
+    //*********************************************************
+    // openIndex
+    //*********************************************************
+    // Opens vehicle.idx, rebuilding it from vehicle.dat if it
+    // is missing or out of step. Called by Util::startup.
+    //*********************************************************
+    static void openIndex();
+
+    //*********************************************************
+    // closeIndex
+    //*********************************************************
+    // Closes vehicle.idx. Called by Util::shutdown.
+    //*********************************************************
+    static void closeIndex();
+
+private:
+    // License -> slot in vehicle.dat
+    static HashIndex index;
+    // vehicle.dat, accessed through index
+    static RecordFile<Vehicle, VehicleKey> records;
+
+    //*********************************************************
+    // makeKey
+    //*********************************************************
+    // Builds the zero-padded index key for a license.
+    // in: license
+    // out: key - LICENSE_PLATE_LENGTH + 1 bytes
+    //*********************************************************
+    static void makeKey(const string &license, char *key);
+};
+
+//*********************************************************
+// VehicleKey
+//*********************************************************
+// Key of a vehicle record for RecordFile: the zero-padded
+// license at the start of the record.
+//*********************************************************
+struct VehicleKey : NoTombstones
+{
+    static const int LENGTH = LICENSE_PLATE_LENGTH + 1;
+
+    static void extract(const char *record, char *key)
+    {
+        memcpy(key, record, LENGTH);
+    }
+};
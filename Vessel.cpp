@@ -7,6 +7,8 @@
 // lane length (LCLL). Used for defining sailings in the
 // reservation system.
 // July 21, 2025 Version 2 - Darpandeep Kaur
+// Oct 17, 2026 Version 3 - Team 18, catalog catches up with
+// other processes
 //*********************************************************
 
 #include "Vessel.h"
@@ -17,6 +19,19 @@
 #include <sstream>
 using namespace std;
 
+//*********************************************************
+// vessel.dat records
+//*********************************************************
+RecordFile<Vessel, VesselKey> Vessel::records(Util::vesselFile,
+                        Util::vesselFileLock, "vessel.dat");
+
+//*********************************************************
+// In-memory copy of vessel.dat, kept in sync by writeVessel
+// and, for other processes' vessels, by loadNewVessels
+//*********************************************************
+unordered_map<string, Vessel> Vessel::catalog;
+int Vessel::catalogCount = 0;
+
 //*********************************************************
 // Default Constructor
 // Initializes the vessel with default values
@@ -89,6 +104,94 @@ void Vessel::readFromFile(fstream &file)
     }
 }
 
+//*********************************************************
+// Reads a vessel record from a buffer in file layout
+// in: record - RECORD_SIZE bytes
+//*********************************************************
+void Vessel::readFromBuffer(const char *record)
+{
+    // Copy vesselName, HCLL, LCLL out of the record
+    memcpy(vesselName, record, NAME_LENGTH + 1);
+    record += NAME_LENGTH + 1;
+    memcpy(&HCLL, record, sizeof(int));
+    record += sizeof(int);
+    memcpy(&LCLL, record, sizeof(int));
+}
+
+//*********************************************************
+// Writes a vessel record into a buffer in file layout
+// out: record - RECORD_SIZE bytes
+//*********************************************************
+void Vessel::writeToBuffer(char *record) const
+{
+    // Copy vesselName, HCLL, LCLL into the record
+    memcpy(record, vesselName, NAME_LENGTH + 1);
+    record += NAME_LENGTH + 1;
+    memcpy(record, &HCLL, sizeof(int));
+    record += sizeof(int);
+    memcpy(record, &LCLL, sizeof(int));
+}
+
+//*********************************************************
+// Looks a vessel up by name in the catalog; never touches
+// the disk
+// in: vesselName
+// out: foundVessel, true if found
+//*********************************************************
+bool Vessel::findVessel(const string &vesselName, 
+                        Vessel &foundVessel)
+{
+    lock_guard<OwnedMutex> lock(Util::vesselLock);
+    auto entry = catalog.find(vesselName);
+    if (entry == catalog.end())
+    {
+        // Perhaps added by another process
+        loadNewVessels();
+        entry = catalog.find(vesselName);
+    }
+    if (entry == catalog.end())
+    {
+        return false;
+    }
+
+    foundVessel = entry->second;
+    return true;
+}
+
+//*********************************************************
+// Reads every vessel record into the catalog
+//*********************************************************
+void Vessel::loadCatalog()
+{
+    lock_guard<OwnedMutex> lock(Util::vesselLock);
+    catalog.clear();
+    catalogCount = 0;
+    loadNewVessels();
+}
+
+//*********************************************************
+// Reads the records after the ones already in the catalog
+//*********************************************************
+void Vessel::loadNewVessels()
+{
+    lock_guard<OwnedMutex> lock(Util::vesselLock);
+    if (records.count() <= catalogCount)
+    {
+        return;
+    }
+
+    Vessel vessel;
+    records.scan([&](const char *record, int slot)
+    {
+        vessel.readFromBuffer(record);
+        // With duplicate names the first record wins, as it
+        // did when vessels were looked up by scanning
+        catalog.emplace(vessel.vesselName, vessel);
+        catalogCount = slot + 1;
+        return true;
+    }, catalogCount);
+}
+
 //*********************************************************
 // Checks if a vessel with the given name exists
 // in: vesselName
@@ -99,28 +202,9 @@ bool Vessel::checkExist(const string &vesselName)
     // Check if the vessel file is open
     if (Util::vesselFile.is_open()) 
     {
-        // Clear any error flags
-        Util::vesselFile.clear();
-        // Move to the beginning of the file
-        Util::vesselFile.seekg(0, ios::beg); 
-
-        // Create a Vessel instance to read records
+        // Create a Vessel instance to hold the record
         Vessel vessel; 
-
-        // Loop through records
-        while (Util::vesselFile.read(reinterpret_cast
-                <char*>(&vessel), Vessel::RECORD_SIZE)) 
-        {
-            // Check if the vessel name matches
-            if (strcmp(vessel.vesselName, 
-                        vesselName.c_str()) == 0) 
-            {
-                // Vessel found, return true
-                return true; 
-            }
-        }
-        // Not found, return false
-        return false; 
+        return findVessel(vesselName, vessel); 
     }
     else
     {
@@ -139,17 +223,19 @@ bool Vessel::checkExist(const string &vesselName)
 bool Vessel::writeVessel(const string &VesselName, 
                             int HCLL, int LCLL)
 {
+    lock_guard<OwnedMutex> lock(Util::vesselLock);
     // Create a Vessel instance with provided values
     Vessel vessel(VesselName, HCLL, LCLL); 
-    // Clear file flags
-    Util::vesselFile.clear();             
-    // Move to the end of the file
-    Util::vesselFile.seekg(0, ios::end);  
-    // Write the vessel record to the file
-    vessel.writeToFile(Util::vesselFile);  
-    // Save to disk
-    Util::vesselFile.flush();    
-    // Return true indicating success         
+    // Append the record and save to disk
+    if (records.append(vessel) < 0) 
+    {
+        return false; 
+    }
+    // Keep the catalog in sync with the file, reading any
+    // vessels other processes added before this one; an
+    // earlier vessel of the same name still wins
+    loadNewVessels(); 
+    // Return true indicating success
     return true; 
 }
 
@@ -188,42 +274,10 @@ string Vessel::getName() const
 //*********************************************************
 int Vessel::getHCLL(const string &vesselName) 
 {
-    // Check if the vessel file is open
-    if (!Util::vesselFile.is_open()) 
-    {
-        // Error message if file is not open
-        cout << "Error: vessel file not open.\n"; 
-        // Return -1 to indicate error
-        return -1; 
-    }
-
-    // Clear any error flags
-    Util::vesselFile.clear(); 
-    // Move to the beginning of the file
-    Util::vesselFile.seekg(0, ios::beg); 
-
-    // Create a Vessel instance to read records
+    // Create a Vessel instance to hold the record
     Vessel v; 
-    // Loop indefinitely until a break condition is met
-    while (true) 
-    {
-        // Read a vessel record
-        v.readFromFile(Util::vesselFile); 
-        // Break if end of file is reached
-        if (Util::vesselFile.eof() 
-            || Util::vesselFile.gcount() == 0) break; 
-
-        // Check if the vessel name matches
-        if (strcmp(v.vesselName, vesselName.c_str()) == 0) 
-        {
-            // Output found vessel name and return HCLL
-            // cout << "\nFound vessel: " << v.vesselName; 
-            // cout << "\nHCLL: " << v.HCLL << endl; 
-            return v.HCLL; 
-        }
-    }
-    // Return -1 if not found
-    return -1; 
+    // Return HCLL if the vessel is found, -1 otherwise
+    return findVessel(vesselName, v) ? v.HCLL : -1; 
 }
 
 //*********************************************************
@@ -233,42 +287,26 @@ int Vessel::getHCLL(const string &vesselName)
 //*********************************************************
 int Vessel::getLCLL(const string &vesselName) 
 {
-    // Clear any error flags
-    Util::vesselFile.clear(); 
-    // Move to the beginning of the file
-    Util::vesselFile.seekg(0, ios::beg); 
-
-    // Create a Vessel instance to read records
+    // Create a Vessel instance to hold the record
     Vessel v; 
-    // Loop indefinitely until a break condition is met
-    while (true) 
-    {
-        // Read a vessel record
-        v.readFromFile(Util::vesselFile); 
-
-        // Break if end of file is reached
-        if (Util::vesselFile.eof() 
-            || Util::vesselFile.gcount() == 0) break; 
-
-        // Check if the vessel name matches
-        if (strcmp(v.vesselName, vesselName.c_str()) == 0) 
-        {
-            // Output found vessel name and return LCLL
-            // cout << "\nFound vessel: " << v.vesselName; 
-            // cout << "\nLCLL: " << v.LCLL << endl; 
-            return v.LCLL; 
-        }
-    }
-    // Return -1 if not found
-    return -1; 
+    // Return LCLL if the vessel is found, -1 otherwise
+    return findVessel(vesselName, v) ? v.LCLL : -1; 
 }
 
 //*********************************************************
-// Calculates and returns total capacity (HCLL + LCLL)
+// Calculates and returns total capacity (HCLL + LCLL) with
+// a single catalog lookup
 // out: total capacity as integer
 //*********************************************************
 int Vessel::getCapacity(const string &vesselName) 
 {
+    // Create a Vessel instance to hold the record
+    Vessel v; 
+    if (!findVessel(vesselName, v)) 
+    {
+        // Same result as getHCLL + getLCLL for a missing vessel
+        return -2; 
+    }
     // Return the total capacity
-    return getHCLL(vesselName) + getLCLL(vesselName); 
-}
\ No newline at end of file
+    return v.HCLL + v.LCLL; 
+}
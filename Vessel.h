@@ -6,15 +6,23 @@
 // values used to initialize new sailings. Stored as binary
 // data.
 // July 20, 2025 Version 3 - All team members
+// Oct 17, 2026 Version 4 - Team 18, lookups served from an
+// in-memory catalog loaded at startup
+// Oct 17, 2026 Version 5 - Team 18, vessels added by other
+// processes read into the catalog
 //*********************************************************
 
 #pragma once
 
+#include "RecordFile.h"
 #include <fstream>
 #include <string>
+#include <unordered_map>
 
 using namespace std;
 
+struct VesselKey;
+
 //*********************************************************
 // Constants
 //*********************************************************
@@ -71,6 +79,23 @@ public:
     //*********************************************************
     void readFromFile(fstream &file);
 
+    //*********************************************************
+    // readFromBuffer
+    //*********************************************************
+    // Fills this vessel from a record held in memory, e.g. a
+    // record handed out by RecordScanner.
+    // in: record - RECORD_SIZE bytes in file layout
+    //*********************************************************
+    void readFromBuffer(const char *record);
+
+    //*********************************************************
+    // writeToBuffer
+    //*********************************************************
+    // Stores this vessel in file layout.
+    // out: record - RECORD_SIZE bytes
+    //*********************************************************
+    void writeToBuffer(char *record) const;
+
     //*********************************************************
     // checkExist
     //*********************************************************
@@ -132,4 +157,56 @@ public:
     // out: total capacity as integer
     //*********************************************************
     static int getCapacity(const std::string &vesselName); 
-};
\ No newline at end of file
+
+    //*********************************************************
+    // loadCatalog
+    //*********************************************************
+    // Reads vessel.dat into the in-memory catalog. Called by
+    // Util::startup.
+    //*********************************************************
+    static void loadCatalog();
+
+private:
+    // vessel.dat records
+    static RecordFile<Vessel, VesselKey> records;
+    // Every vessel in vessel.dat, by name
+    static unordered_map<string, Vessel> catalog;
+    // Records of vessel.dat read into the catalog so far
+    static int catalogCount;
+
+    //*********************************************************
+    // loadNewVessels
+    //*********************************************************
+    // vessel.dat is only ever appended to, so the catalog is
+    // brought up to date with other processes by reading the
+    // records after the ones it already holds.
+    //*********************************************************
+    static void loadNewVessels();
+
+    //*********************************************************
+    // findVessel
+    //*********************************************************
+    // Looks a vessel up by name in the catalog, first
+    // reading any vessels added since if it is not there.
+    // in: vesselName
+    // out: foundVessel, true if found
+    //*********************************************************
+    static bool findVessel(const string &vesselName, 
+                            Vessel &foundVessel);
+};
+
+//*********************************************************
+// VesselKey
+//*********************************************************
+// Key of a vessel record for RecordFile: the zero-padded
+// vessel name at the start of the record.
+//*********************************************************
+struct VesselKey : NoTombstones
+{
+    static const int LENGTH = NAME_LENGTH + 1;
+
+    static void extract(const char *record, char *key)
+    {
+        memcpy(key, record, LENGTH);
+    }
+};
@@ -0,0 +1,334 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// WalTestDriver.cpp
+//*********************************************************
+// Purpose: Test driver for write-ahead log replay. Runs a
+// few operations on one sailing, keeps a copy of ferry.wal
+// as it stood before the clean shutdown, then simulates
+// crashes by putting the data files back as they were
+// before the operations and the saved log in place of the
+// emptied one, and starting up again:
+// - torn trailing entry: a last entry cut short or failing
+//   its checksum is ignored; the entries before it are
+//   replayed
+// - garbled middle entry: an entry failing its checksum
+//   is skipped; the entries on both sides are replayed
+// - replay twice: the same log replayed over data that
+//   already has its changes leaves the data as it was
+// Prints PASS or FAIL per check; exits with the number of
+// failures.
+//
+// Usage: waltest [-d dir]
+//   -d dir  scratch directory (default waltest_data)
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, garbled middle entry
+//*********************************************************
+
+#include "Util.h"
+#include "OtherControls.h"
+#include "SailingControl.h"
+#include "SailingVersions.h"
+#include "Reservation.h"
+#include "Sailing.h"
+#include "WriteAheadLog.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+using namespace std;
+
+static const string SAILING_ID = "wal-01-10";
+static const string LOG_FILE = "ferry.wal";
+// Copies of the data files from before the operations
+static const string BEFORE_DIR = "before";
+static const char *DATA_FILES[] = {
+    "vessel.dat", "sailing.dat", "reservation.dat", "vehicle.dat"
+};
+// Vehicles booked by the test
+static const int BOOKED = 4;
+
+static int failures = 0;
+// The real stdout; cout is captured while the system runs
+static ostream out(nullptr);
+
+//*********************************************************
+// Reports one check
+//*********************************************************
+static void check(bool passed, const string &name)
+{
+    out << (passed ? "PASS " : "FAIL ") << name << endl;
+    if (!passed)
+    {
+        failures++;
+    }
+}
+
+//*********************************************************
+// The i-th test license plate
+//*********************************************************
+static string licenseFor(int i)
+{
+    return "WAL" + to_string(i);
+}
+
+//*********************************************************
+// Reads a whole file
+//*********************************************************
+static string readFile(const string &fileName)
+{
+    ifstream file(fileName, ios::binary);
+    ostringstream bytes;
+    bytes << file.rdbuf();
+    return bytes.str();
+}
+
+//*********************************************************
+// Replaces a file with the given bytes
+//*********************************************************
+static void writeFile(const string &fileName, const string &bytes)
+{
+    ofstream file(fileName, ios::binary | ios::trunc);
+    file.write(bytes.data(), bytes.size());
+}
+
+//*********************************************************
+// Copies the data files between the working directory and
+// BEFORE_DIR
+//*********************************************************
+static void copyData(bool save)
+{
+    for (const char *name : DATA_FILES)
+    {
+        filesystem::path saved = filesystem::path(BEFORE_DIR) / name;
+        filesystem::copy_file(save ? name : saved,
+                save ? saved : filesystem::path(name),
+                filesystem::copy_options::overwrite_existing);
+    }
+}
+
+//*********************************************************
+// Starts the system up on a log left by a crash
+// in: log - bytes left in ferry.wal
+//     restoreData - true to put back the data files from
+//     before the operations
+// out: number of entries startup replayed
+//*********************************************************
+static int restartAfterCrash(const string &log, bool restoreData)
+{
+    if (restoreData)
+    {
+        copyData(false);
+    }
+    writeFile(LOG_FILE, log);
+
+    ostringstream startup;
+    streambuf *oldOut = cout.rdbuf(startup.rdbuf());
+    Util::startup();
+    cout.rdbuf(oldOut);
+
+    int replayed = 0;
+    string text = startup.str();
+    size_t at = text.find("Replayed ");
+    if (at != string::npos)
+    {
+        replayed = stoi(text.substr(at + strlen("Replayed ")));
+    }
+    return replayed;
+}
+
+//*********************************************************
+// The sailing's row, with live cleared if it is not found
+//*********************************************************
+static SailingVersions::Row sailingRow()
+{
+    SailingVersions::Row row;
+    memset(&row, 0, sizeof(row));
+    uint32_t key = 0;
+    if (!Sailing::isValidSailingId(SAILING_ID, key)
+        || !SailingVersions::read(key, row))
+    {
+        row.live = false;
+    }
+    return row;
+}
+
+//*********************************************************
+// Whether the sailing holds the expected bookings
+// in: booked - licenses expected on the sailing, by number
+//     checkedIn - how many of them are checked in
+//*********************************************************
+static bool holds(const bool booked[BOOKED], int checkedIn)
+{
+    int vehicles = 0;
+    for (int i = 0; i < BOOKED; i++)
+    {
+        if (Reservation::checkExist(licenseFor(i), SAILING_ID)
+                != booked[i])
+        {
+            return false;
+        }
+        vehicles += booked[i] ? 1 : 0;
+    }
+
+    SailingVersions::Row row = sailingRow();
+    int length = Util::toDecimetres(7.1) + Sailing::VEHICLE_GAP;
+    return row.live && row.vehicles == vehicles
+        && row.checkedIn == checkedIn
+        && row.usedHigh + row.usedLow == vehicles * length;
+}
+
+//*********************************************************
+// Runs the logged operations and returns the log as it
+// stood before the clean shutdown emptied it
+//*********************************************************
+static string runOperations()
+{
+    Util::startup();
+    Util::reset();
+    string vesselName = "WalQueen";
+    OtherControls::createVessel(vesselName, 500, 500);
+    SailingControl::createSailing(SAILING_ID, vesselName);
+    Util::shutdown();
+    copyData(true);
+
+    Util::startup();
+    string phone = "6045551234";
+    string sailingId = SAILING_ID;
+    for (int i = 0; i < BOOKED; i++)
+    {
+        string license = licenseFor(i);
+        OtherControls::createReservation(phone, sailingId,
+                        license, Util::toDecimetres(2.1),
+                        Util::toDecimetres(7.1));
+    }
+    string checkedIn = licenseFor(0);
+    OtherControls::checkIn(checkedIn, sailingId);
+    string cancelled = licenseFor(1);
+    OtherControls::deleteReservation(cancelled, sailingId);
+
+    // Every entry is committed, so the log is complete on
+    // disk before the shutdown empties it
+    string log = readFile(LOG_FILE);
+    Util::shutdown();
+    return log;
+}
+
+//*********************************************************
+// torn trailing entry
+//*********************************************************
+static void testTornEntry(const string &log)
+{
+    const size_t entrySize = sizeof(WriteAheadLog::Entry);
+    const bool beforeCancel[BOOKED] = {true, true, true, true};
+
+    // The cancellation, written last, cut in half
+    string torn = log.substr(0, log.size() - entrySize / 2);
+    int replayed = restartAfterCrash(torn, true);
+    check(replayed == BOOKED + 1,
+            "torn entry: entries before a cut-short one replayed");
+    check(holds(beforeCancel, 1),
+            "torn entry: cut-short cancellation not applied");
+    Util::shutdown();
+
+    // Full length, but its bytes do not match its checksum
+    string garbled = log;
+    garbled[garbled.size() - entrySize / 2] ^= 0x5A;
+    replayed = restartAfterCrash(garbled, true);
+    check(replayed == BOOKED + 1,
+            "torn entry: entries before a garbled one replayed");
+    check(holds(beforeCancel, 1),
+            "torn entry: garbled cancellation not applied");
+    Util::shutdown();
+
+    restartAfterCrash("", false);
+    check(holds(beforeCancel, 1),
+            "torn entry: replayed changes kept after a restart");
+    Util::shutdown();
+}
+
+//*********************************************************
+// garbled middle entry
+//*********************************************************
+static void testGarbledMiddle(const string &log)
+{
+    const size_t entrySize = sizeof(WriteAheadLog::Entry);
+    const bool afterCancel[BOOKED] = {true, false, true, true};
+
+    // The check-in, second to last, fails its checksum
+    string garbled = log;
+    garbled[garbled.size() - entrySize - entrySize / 2] ^= 0x5A;
+    int replayed = restartAfterCrash(garbled, true);
+    check(replayed == BOOKED + 1,
+            "garbled middle: entries on both sides replayed");
+    check(holds(afterCancel, 0),
+            "garbled middle: cancellation after it applied");
+    Util::shutdown();
+}
+
+//*********************************************************
+// replay twice
+//*********************************************************
+static void testReplayTwice(const string &log)
+{
+    const bool afterCancel[BOOKED] = {true, false, true, true};
+
+    int replayed = restartAfterCrash(log, true);
+    check(replayed == BOOKED + 2 && holds(afterCancel, 1),
+            "replay twice: whole log replayed once");
+    SailingVersions::Row first = sailingRow();
+    Util::shutdown();
+
+    // The same entries again, over data that has them all
+    replayed = restartAfterCrash(log, false);
+    SailingVersions::Row second = sailingRow();
+    check(replayed == BOOKED + 2 && holds(afterCancel, 1),
+            "replay twice: second replay changes nothing");
+    check(first.usedHigh == second.usedHigh
+            && first.usedLow == second.usedLow
+            && first.vehicles == second.vehicles
+            && first.checkedIn == second.checkedIn,
+            "replay twice: lanes and counts unchanged");
+    Util::shutdown();
+}
+
+int main(int argc, char *argv[])
+{
+    string directory = "waltest_data";
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "-d" && i + 1 < argc)
+        {
+            directory = argv[++i];
+        }
+        else
+        {
+            cerr << "Usage: waltest [-d dir]" << endl;
+            return 1;
+        }
+    }
+
+    filesystem::create_directories(directory);
+    filesystem::current_path(directory);
+    filesystem::create_directories(BEFORE_DIR);
+
+    // Results go to the real stdout; everything the system
+    // prints while it runs is discarded
+    out.rdbuf(cout.rdbuf());
+    ostringstream discarded;
+    cout.rdbuf(discarded.rdbuf());
+
+    string log = runOperations();
+    check(log.size() == (BOOKED + 3) * sizeof(WriteAheadLog::Entry),
+            "log holds a marker and one entry per operation");
+
+    testTornEntry(log);
+    testGarbledMiddle(log);
+    testReplayTwice(log);
+
+    out << failures << " failed" << endl;
+    cout.rdbuf(out.rdbuf());
+    return failures;
+}
@@ -0,0 +1,666 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// WriteAheadLog.cpp
+//*********************************************************
+// Purpose: Implements the write-ahead log, its group
+// commit, checkpoints and replay at startup.
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, wasLeftOpen
+// Oct 17, 2026 Version 3 - Team 18, entries committed before
+// the change they log
+// Oct 17, 2026 Version 4 - Team 18, failed writes cut off
+// the log; replay skips entries that fail their checksum
+// Oct 17, 2026 Version 5 - Team 18, isOnlyProcess and the
+// watcher thread
+//*********************************************************
+
+#include "WriteAheadLog.h"
+#include "OtherControls.h"
+#include "SailingControl.h"
+#include "Sailing.h"
+#include "Util.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+using namespace std;
+
+int WriteAheadLog::fd = -1;
+string WriteAheadLog::fileName;
+FileLock WriteAheadLog::fileLock;
+atomic<bool> WriteAheadLog::alone(true);
+thread WriteAheadLog::watcher;
+mutex WriteAheadLog::watchLock;
+condition_variable WriteAheadLog::watchWanted;
+bool WriteAheadLog::stopRequested = false;
+shared_mutex WriteAheadLog::operations;
+mutex WriteAheadLog::logLock;
+condition_variable WriteAheadLog::synced;
+vector<char> WriteAheadLog::pending;
+uint64_t WriteAheadLog::lastLsn = 0;
+uint64_t WriteAheadLog::writtenLsn = 0;
+uint64_t WriteAheadLog::durableLsn = 0;
+vector<pair<uint64_t, uint64_t>> WriteAheadLog::failedBatches;
+bool WriteAheadLog::syncing = false;
+bool WriteAheadLog::failed = false;
+bool WriteAheadLog::checkpointDue = false;
+size_t WriteAheadLog::logBytes = 0;
+bool WriteAheadLog::leftOpen = false;
+bool WriteAheadLog::replaying = false;
+
+//*********************************************************
+// Entry constructor
+//*********************************************************
+WriteAheadLog::Entry::Entry(Type type)
+{
+    memset(static_cast<void *>(this), 0, sizeof(Entry));
+    this->type = type;
+}
+
+//*********************************************************
+// open()
+//*********************************************************
+bool WriteAheadLog::open(const string &fileName)
+{
+    stopWatcher();
+    lock_guard<mutex> lock(logLock);
+    if (fd >= 0)
+    {
+        ::close(fd);
+    }
+
+    WriteAheadLog::fileName = fileName;
+    fd = ::open(fileName.c_str(), O_RDWR | O_CREAT | O_APPEND,
+                0644);
+    if (fd < 0)
+    {
+        cerr << "Could not open " << fileName
+            << "; changes are not logged." << endl;
+        return false;
+    }
+
+    fileLock.open(fileName);
+
+    // The exclusive lock is only granted if no other process
+    // has the log open. Otherwise the live byte is shared,
+    // which waits for a process alone to write back its
+    // lanes; the join byte tells its watcher to do so.
+    fileLock.lock(JOIN_BYTE, 1, false);
+    bool first = fileLock.tryLock(LIVE_BYTE, 1, true);
+    if (!first)
+    {
+        fileLock.lock(LIVE_BYTE, 1, false);
+    }
+    fileLock.unlock(JOIN_BYTE, 1);
+    alone = first;
+
+    pending.clear();
+    lastLsn = 0;
+    writtenLsn = 0;
+    durableLsn = 0;
+    failedBatches.clear();
+    failed = false;
+    checkpointDue = false;
+    logBytes = static_cast<size_t>(lseek(fd, 0, SEEK_END));
+    leftOpen = first && logBytes > 0;
+    if (logBytes == 0)
+    {
+        writeRunning();
+    }
+
+    {
+        lock_guard<mutex> watching(watchLock);
+        stopRequested = false;
+    }
+    watcher = thread(watchLoop);
+    return true;
+}
+
+//*********************************************************
+// wasLeftOpen()
+//*********************************************************
+bool WriteAheadLog::wasLeftOpen()
+{
+    lock_guard<mutex> lock(logLock);
+    return leftOpen;
+}
+
+//*********************************************************
+// recover()
+// Reads the log into memory and replays every entry that
+// passes its checksum. Writers cut off their failed and
+// torn writes, so a bad entry is one garbled on disk; the
+// committed entries after it are still replayed.
+//*********************************************************
+int WriteAheadLog::recover()
+{
+    vector<char> log;
+    {
+        lock_guard<mutex> lock(logLock);
+        if (fd < 0 || !leftOpen)
+        {
+            return 0;
+        }
+
+        RangeLock shared(fileLock, 0, LOG_RANGE, false);
+        char block[4096];
+        ssize_t got;
+        off_t offset = 0;
+        while ((got = pread(fd, block, sizeof(block), offset)) > 0)
+        {
+            log.insert(log.end(), block, block + got);
+            offset += got;
+        }
+        replaying = true;
+    }
+
+    // The controls report as they go; replay keeps quiet
+    streambuf *oldOut = cout.rdbuf(nullptr);
+
+    int replayed = 0;
+    for (size_t at = 0; at + sizeof(Entry) <= log.size();
+            at += sizeof(Entry))
+    {
+        Entry entry(CREATE_RESERVATION);
+        memcpy(static_cast<void *>(&entry), log.data() + at,
+                sizeof(Entry));
+        if (entry.checksum != checksumOf(entry))
+        {
+            continue; // Garbled, or torn at the tail
+        }
+
+        if (entry.type != RUNNING)
+        {
+            replay(entry);
+            replayed++;
+        }
+    }
+
+    cout.rdbuf(oldOut);
+    {
+        lock_guard<mutex> lock(logLock);
+        replaying = false;
+    }
+
+    if (replayed > 0)
+    {
+        cout << "Replayed " << replayed
+            << " logged operations." << endl;
+    }
+    checkpoint();
+    return replayed;
+}
+
+//*********************************************************
+// close()
+//*********************************************************
+void WriteAheadLog::close()
+{
+    stopWatcher();
+
+    // The last process to close empties the log; with others
+    // still using it, the log and its RUNNING entry are left
+    // to them
+    if (fileLock.tryLock(LIVE_BYTE, 1, true))
+    {
+        alone = true;
+    }
+    checkpoint(false);
+
+    lock_guard<mutex> lock(logLock);
+    if (fd >= 0)
+    {
+        fileLock.close();
+        ::close(fd);
+        fd = -1;
+    }
+    alone = true;
+}
+
+//*********************************************************
+// isOnlyProcess()
+//*********************************************************
+bool WriteAheadLog::isOnlyProcess()
+{
+    return alone;
+}
+
+//*********************************************************
+// watchLoop()
+// Both changes are made with no operation running, so no
+// booking straddles them. Taking the live byte back is
+// done first, since a process that holds it exclusively
+// is already alone whatever its flag says; the flag only
+// chooses the slower, always safe path meanwhile.
+//*********************************************************
+void WriteAheadLog::watchLoop()
+{
+    unique_lock<mutex> lock(watchLock);
+    while (!stopRequested)
+    {
+        watchWanted.wait_for(lock,
+                    chrono::milliseconds(WATCH_INTERVAL_MS));
+        if (stopRequested)
+        {
+            break;
+        }
+        lock.unlock();
+
+        if (alone)
+        {
+            // The probe only fails while a process is
+            // waiting to join
+            if (fileLock.tryLock(JOIN_BYTE, 1, true))
+            {
+                fileLock.unlock(JOIN_BYTE, 1);
+            }
+            else
+            {
+                unique_lock<shared_mutex> quiet(operations);
+                Sailing::flushCapacity();
+                alone = false;
+                fileLock.lock(LIVE_BYTE, 1, false);
+            }
+        }
+        else if (fileLock.tryLock(LIVE_BYTE, 1, true))
+        {
+            unique_lock<shared_mutex> quiet(operations);
+            Sailing::reloadCapacity();
+            alone = true;
+
+            // The entries the others left count towards the
+            // next checkpoint, which can now empty the log
+            lock_guard<mutex> logged(logLock);
+            off_t size = lseek(fd, 0, SEEK_END);
+            logBytes = size > 0 ? static_cast<size_t>(size) : 0;
+            checkpointDue = checkpointDue
+                || logBytes >= static_cast<size_t>(CHECKPOINT_BYTES);
+        }
+
+        lock.lock();
+    }
+}
+
+//*********************************************************
+// stopWatcher()
+//*********************************************************
+void WriteAheadLog::stopWatcher()
+{
+    if (watcher.joinable())
+    {
+        {
+            lock_guard<mutex> lock(watchLock);
+            stopRequested = true;
+        }
+        watchWanted.notify_all();
+        watcher.join();
+    }
+}
+
+//*********************************************************
+// beginOperation()
+// A committer holds its operation lock, so the checkpoint
+// it finds due is taken here, before this operation's lock
+//*********************************************************
+shared_lock<shared_mutex> WriteAheadLog::beginOperation()
+{
+    bool due;
+    {
+        lock_guard<mutex> lock(logLock);
+        due = checkpointDue;
+    }
+    if (due)
+    {
+        checkpoint();
+    }
+    return shared_lock<shared_mutex>(operations);
+}
+
+//*********************************************************
+// append()
+//*********************************************************
+uint64_t WriteAheadLog::append(Entry &entry)
+{
+    lock_guard<mutex> lock(logLock);
+    if (fd < 0 || replaying)
+    {
+        return 0;
+    }
+
+    entry.lsn = ++lastLsn;
+    entry.checksum = checksumOf(entry);
+
+    const char *bytes = reinterpret_cast<const char *>(&entry);
+    pending.insert(pending.end(), bytes, bytes + sizeof(Entry));
+    return entry.lsn;
+}
+
+//*********************************************************
+// commit()
+// The leader takes the whole buffer, so one write and one
+// sync cover every entry appended while the previous sync
+// was running. A batch that could not be written is
+// recorded, so its committers fail even after later
+// batches succeed.
+//*********************************************************
+bool WriteAheadLog::commit(uint64_t lsn)
+{
+    if (lsn == 0)
+    {
+        return true;
+    }
+
+    unique_lock<mutex> lock(logLock);
+    while (writtenLsn < lsn)
+    {
+        if (syncing)
+        {
+            synced.wait(lock);
+            continue;
+        }
+
+        // Lead this group
+        syncing = true;
+        vector<char> batch;
+        batch.swap(pending);
+        uint64_t firstLsn = writtenLsn + 1;
+        uint64_t batchLsn = lastLsn;
+        bool usable = !failed;
+        lock.unlock();
+
+        bool leftBehind = false;
+        bool written = usable
+            && writeSynced(batch.data(), batch.size(), leftBehind);
+
+        lock.lock();
+        syncing = false;
+        writtenLsn = batchLsn;
+        if (written)
+        {
+            // Entries after a failed batch are on disk, but
+            // the ones before them are not
+            if (durableLsn + 1 == firstLsn)
+            {
+                durableLsn = batchLsn;
+            }
+            logBytes += batch.size();
+        }
+        else
+        {
+            failedBatches.emplace_back(firstLsn, batchLsn);
+            failed = failed || leftBehind;
+        }
+        checkpointDue = checkpointDue
+            || logBytes >= static_cast<size_t>(CHECKPOINT_BYTES);
+        synced.notify_all();
+
+        if (!written)
+        {
+            cerr << "Could not write " << fileName << endl;
+        }
+        if (leftBehind)
+        {
+            cerr << "Could not remove a failed write from "
+                << fileName << "; nothing more is logged."
+                << endl;
+        }
+    }
+
+    for (const pair<uint64_t, uint64_t> &batch : failedBatches)
+    {
+        if (lsn >= batch.first && lsn <= batch.second)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//*********************************************************
+// checkpoint()
+// With no operation running, everything this process logged
+// is already in the .dat files (or in their stream buffers
+// and the capacity table), so once those are synced the log
+// can be emptied if no other process is using it
+//*********************************************************
+void WriteAheadLog::checkpoint()
+{
+    checkpoint(true);
+}
+
+//*********************************************************
+// checkpoint() with marker choice
+//*********************************************************
+void WriteAheadLog::checkpoint(bool stillRunning)
+{
+    unique_lock<shared_mutex> quiet(operations);
+
+    Sailing::flushCapacity();
+
+    // Flush stream buffers, in lock order
+    {
+        lock_guard<OwnedMutex> lock(Util::vesselLock);
+        Util::vesselFile.flush();
+    }
+    {
+        lock_guard<OwnedMutex> lock(Util::sailingLock);
+        Util::sailingFile.flush();
+    }
+    {
+        lock_guard<OwnedMutex> lock(Util::reservationLock);
+        Util::reservationFile.flush();
+    }
+    {
+        lock_guard<OwnedMutex> lock(Util::vehicleLock);
+        Util::vehicleFile.flush();
+    }
+
+    syncFile("vessel.dat");
+    syncFile("sailing.dat");
+    syncFile("reservation.dat");
+    syncFile("vehicle.dat");
+
+    unique_lock<mutex> lock(logLock);
+    synced.wait(lock, []() { return !syncing; });
+
+    // Entries still buffered are covered by the sync above
+    pending.clear();
+    writtenLsn = lastLsn;
+    durableLsn = lastLsn;
+    failedBatches.clear();
+    logBytes = 0;
+    checkpointDue = false;
+
+    // Entries other processes logged may not be in the .dat
+    // files yet, so only a process alone empties the log;
+    // otherwise this process's share of it is just left
+    // behind, covered by the sync above
+    if (fd >= 0 && alone)
+    {
+        RangeLock whole(fileLock, 0, LOG_RANGE, true);
+        if (ftruncate(fd, 0) != 0)
+        {
+            cerr << "Could not empty " << fileName << endl;
+        }
+        else
+        {
+            // Nothing a failed write left behind remains
+            failed = false;
+        }
+    }
+    if (stillRunning && alone)
+    {
+        writeRunning();
+    }
+    synced.notify_all();
+}
+
+//*********************************************************
+// writeRunning()
+//*********************************************************
+void WriteAheadLog::writeRunning()
+{
+    if (fd < 0)
+    {
+        return;
+    }
+
+    Entry entry(RUNNING);
+    entry.checksum = checksumOf(entry);
+
+    bool leftBehind = false;
+    if (!writeSynced(reinterpret_cast<const char *>(&entry),
+                        sizeof(Entry), leftBehind))
+    {
+        cerr << "Could not write " << fileName << endl;
+        failed = failed || leftBehind;
+        return;
+    }
+    logBytes = sizeof(Entry);
+}
+
+//*********************************************************
+// writeSynced()
+// Other processes are locked out from the end of the log
+// until the write is synced, so a failed one can be cut off
+// again without cutting off theirs
+//*********************************************************
+bool WriteAheadLog::writeSynced(const char *bytes, size_t size,
+                                bool &leftBehind)
+{
+    leftBehind = false;
+    RangeLock whole(fileLock, 0, LOG_RANGE, true);
+
+    // A writer that died part way through an entry left the
+    // start of it at the end; it is cut off first
+    off_t end = lseek(fd, 0, SEEK_END);
+    if (end < 0)
+    {
+        return false;
+    }
+    off_t torn = end % static_cast<off_t>(sizeof(Entry));
+    if (torn != 0)
+    {
+        end -= torn;
+        if (ftruncate(fd, end) != 0)
+        {
+            return false;
+        }
+    }
+
+    bool written = true;
+    size_t done = 0;
+    while (done < size)
+    {
+        ssize_t wrote = write(fd, bytes + done, size - done);
+        if (wrote < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (wrote <= 0)
+        {
+            written = false;
+            break;
+        }
+        done += static_cast<size_t>(wrote);
+    }
+    written = written && fdatasync(fd) == 0;
+
+    // Entries whose commit fails must not be replayed
+    if (!written && (ftruncate(fd, end) != 0 || fdatasync(fd) != 0))
+    {
+        leftBehind = true;
+    }
+    return written;
+}
+
+//*********************************************************
+// copyField()
+//*********************************************************
+void WriteAheadLog::copyField(char *field, size_t size,
+                                const string &text)
+{
+    size_t length = min(text.size(), size - 1);
+    memcpy(field, text.data(), length);
+    field[length] = '\0';
+}
+
+//*********************************************************
+// checksumOf()
+//*********************************************************
+uint32_t WriteAheadLog::checksumOf(const Entry &entry)
+{
+    const unsigned char *bytes =
+                reinterpret_cast<const unsigned char *>(&entry);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(Entry, checksum); i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+//*********************************************************
+// replay()
+// Each control checks the current state before changing
+// it, so an entry whose change already reached the .dat
+// files does nothing, and one committed just before a
+// crash is applied here
+//*********************************************************
+void WriteAheadLog::replay(const Entry &entry)
+{
+    string sailingId = Sailing::sailingIdFromKey(entry.sailingKey);
+    string license(entry.license,
+                    strnlen(entry.license, sizeof(entry.license)));
+    string phone(entry.phone,
+                    strnlen(entry.phone, sizeof(entry.phone)));
+    string vesselName(entry.vesselName,
+                    strnlen(entry.vesselName,
+                            sizeof(entry.vesselName)));
+
+    switch (entry.type)
+    {
+    case CREATE_RESERVATION:
+        OtherControls::createReservation(phone, sailingId,
+                                license, entry.height,
+                                entry.length);
+        break;
+    case DELETE_RESERVATION:
+        OtherControls::deleteReservation(license, sailingId);
+        break;
+    case CHECK_IN:
+        OtherControls::checkIn(license, sailingId);
+        break;
+    case CREATE_SAILING:
+        SailingControl::createSailing(sailingId, vesselName);
+        break;
+    case DELETE_SAILING:
+        SailingControl::deleteSailing(sailingId, true);
+        break;
+    case CREATE_VESSEL:
+        OtherControls::createVessel(vesselName, entry.height,
+                                    entry.length);
+        break;
+    default:
+        break;
+    }
+}
+
+//*********************************************************
+// syncFile()
+//*********************************************************
+void WriteAheadLog::syncFile(const string &name)
+{
+    int dataFd = ::open(name.c_str(), O_RDONLY);
+    if (dataFd >= 0)
+    {
+        fsync(dataFd);
+        ::close(dataFd);
+    }
+}
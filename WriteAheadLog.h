@@ -0,0 +1,352 @@
+//@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+//*********************************************************
+// WriteAheadLog.h
+//*********************************************************
+// Purpose: Log of every logical change (create, cancel and
+// check in a reservation, create and delete a sailing,
+// create a vessel), one fixed-size entry per operation in
+// ferry.wal. An operation is committed once its entry is
+// synced to disk; the .dat files behind it are only synced
+// at a checkpoint.
+//
+// Write-ahead: a control first checks that its operation
+// can go ahead, then appends and commits the entry, and
+// only then changes the .dat files and SailingVersions. If
+// the commit fails nothing has been changed and the control
+// reports failure. Once it succeeds the operation counts as
+// done, so a crash before the change is written is covered
+// by replay. The lanes in the capacity table are the one
+// change made before the commit, since taking space is how
+// a booking checks for it; they are given back if the
+// commit fails, and rebuilt from reservation.dat after a
+// crash.
+//
+// Group commit: entries are buffered in memory. The first
+// committer to find no sync in progress becomes the leader
+// and writes and syncs everything buffered so far; the
+// others wait on a condition variable and are released by
+// that one sync. The leader holds the whole log exclusively
+// from the write to the end of the sync; if either fails,
+// the batch is cut off the log again and every committer in
+// it is told so, while later batches go ahead.
+//
+// Checkpoint: the .dat files are synced and the log is
+// emptied, at shutdown and whenever the log passes
+// CHECKPOINT_BYTES. A process that is not alone (see below)
+// syncs but leaves the log, whose other entries may not be
+// in the .dat files yet; the last one to run empties it.
+// While a process runs the log starts with a RUNNING
+// entry, so only a clean shutdown leaves it empty.
+// At startup whatever is left in the log
+// is replayed through the controls. Replay is idempotent:
+// each operation checks the current state first (a
+// reservation that exists is not booked again, and so on).
+//
+// Other processes: each process holds a lock on the live
+// byte for as long as it has the log open. One that holds
+// it exclusively is alone (isOnlyProcess) and books lane
+// space from its capacity table only. A process opening
+// the log holds the join byte shared while it waits for
+// the live byte; the watcher thread of the process alone
+// sees this, writes back its lanes and shares the live
+// byte, and from then on both book under the sailing's
+// record lock. A watcher that can take the live byte
+// exclusively again merges sailing.dat into its table and
+// is alone once more.
+// Oct 17, 2026 Version 1 - Team 18
+// Oct 17, 2026 Version 2 - Team 18, wasLeftOpen
+// Oct 17, 2026 Version 3 - Team 18, entries committed before
+// the change they log
+// Oct 17, 2026 Version 4 - Team 18, failed writes cut off
+// the log; replay skips entries that fail their checksum
+// Oct 17, 2026 Version 5 - Team 18, isOnlyProcess and the
+// watcher thread
+//*********************************************************
+
+#pragma once
+
+#include "FileLock.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class WriteAheadLog
+{
+public:
+    // Log size that triggers a checkpoint after a commit
+    static const int CHECKPOINT_BYTES = 1 << 20;
+    // How often the watcher checks for other processes
+    static constexpr int WATCH_INTERVAL_MS = 200;
+
+    // Kinds of logged operation
+    enum Type
+    {
+        CREATE_RESERVATION = 1,
+        DELETE_RESERVATION,
+        CHECK_IN,
+        CREATE_SAILING,
+        DELETE_SAILING,
+        CREATE_VESSEL,
+        // Marks a log in use; replays as nothing
+        RUNNING
+    };
+
+    //*********************************************************
+    // Entry
+    //*********************************************************
+    // One logged operation, stored as is. Fields an operation
+    // does not use are left zero.
+    //*********************************************************
+    struct Entry
+    {
+        uint32_t type;
+        // Encoded sailing ID (Sailing::isValidSailingId)
+        uint32_t sailingKey;
+        uint64_t lsn;
+        // Vehicle height and length in decimetres, or a new
+        // vessel's HCLL and LCLL in metres
+        int32_t height;
+        int32_t length;
+        char license[11];
+        char phone[15];
+        char vesselName[26];
+        // Over every byte before it; a torn entry fails it
+        uint32_t checksum;
+
+        //*****************************************************
+        // Constructor
+        //*****************************************************
+        // Zeroes every byte, padding included.
+        //*****************************************************
+        explicit Entry(Type type);
+    };
+
+    //*********************************************************
+    // open
+    //*********************************************************
+    // Opens (or creates) the log. Called by Util::startup.
+    // in: fileName
+    // out: true if the log is usable
+    //*********************************************************
+    static bool open(const string &fileName);
+
+    //*********************************************************
+    // wasLeftOpen
+    //*********************************************************
+    // A clean shutdown leaves the log empty, so anything in
+    // it when it is opened, even just a RUNNING entry, means
+    // the last run stopped without one, possibly half way
+    // through an operation. Never set while another process
+    // has the log open, since the log is then in use.
+    // out: true if the log held anything when opened and no
+    // other process was using it
+    //*********************************************************
+    static bool wasLeftOpen();
+
+    //*********************************************************
+    // recover
+    //*********************************************************
+    // If the log was left open (see wasLeftOpen), replays
+    // every entry in it that passes its checksum, then takes
+    // a checkpoint.
+    // Called by Util::startup once the data files and indexes
+    // are open.
+    // out: number of entries replayed
+    //*********************************************************
+    static int recover();
+
+    //*********************************************************
+    // close
+    //*********************************************************
+    // Takes a final checkpoint and closes the log, leaving it
+    // empty unless another process still uses it. Called by
+    // Util::shutdown before the data files are closed.
+    //*********************************************************
+    static void close();
+
+    //*********************************************************
+    // isOnlyProcess
+    //*********************************************************
+    // out: true if no other process has the log open, so
+    // the in-memory state is the only copy being changed;
+    // also true when the log is not open
+    //*********************************************************
+    static bool isOnlyProcess();
+
+    //*********************************************************
+    // beginOperation
+    //*********************************************************
+    // Shared lock a control holds from its first check until
+    // its change is applied, so a checkpoint never finds an
+    // entry in the log whose change is not yet made. Taken
+    // before any other lock; first takes the checkpoint a
+    // commit found due, if any.
+    //*********************************************************
+    static shared_lock<shared_mutex> beginOperation();
+
+    //*********************************************************
+    // append
+    //*********************************************************
+    // Buffers an entry for the next group commit. Nothing is
+    // logged while replaying or when the log is not open.
+    // in: entry - lsn and checksum are filled in here
+    // out: its log sequence number, 0 if not logged
+    //*********************************************************
+    static uint64_t append(Entry &entry);
+
+    //*********************************************************
+    // commit
+    //*********************************************************
+    // Waits until the entry is on disk, leading the sync if
+    // none is running. Takes no other lock, so the caller may
+    // hold the operation lock and its stripes, but should not
+    // hold a data lock others need meanwhile. Once the log
+    // passes CHECKPOINT_BYTES a checkpoint is left due for
+    // the next beginOperation.
+    // in: lsn - from append; 0 returns at once
+    // out: false if the entry's batch could not be written
+    //*********************************************************
+    static bool commit(uint64_t lsn);
+
+    //*********************************************************
+    // checkpoint
+    //*********************************************************
+    // Syncs the .dat files and empties the log, if no other
+    // process is using it.
+    //*********************************************************
+    static void checkpoint();
+
+    //*********************************************************
+    // copyField
+    //*********************************************************
+    // Copies text into a fixed entry field, cut to fit.
+    //*********************************************************
+    static void copyField(char *field, size_t size,
+                            const string &text);
+
+private:
+    // Bytes of the log covered by its range locks; the two
+    // bytes right after them are the live and join bytes
+    static constexpr off_t LOG_RANGE = off_t(1) << 40;
+    static constexpr off_t LIVE_BYTE = LOG_RANGE;
+    static constexpr off_t JOIN_BYTE = LOG_RANGE + 1;
+
+    static int fd;
+    static string fileName;
+    // Keeps the log in step with other ferry processes:
+    // shared while reading it back, exclusive while writing
+    // or emptying it. Leaders lock the log and the watcher
+    // the two bytes after it, so their ranges never overlap.
+    static FileLock fileLock;
+
+    // Set while this process holds the live byte exclusively
+    static atomic<bool> alone;
+    static thread watcher;
+    static mutex watchLock;
+    static condition_variable watchWanted;
+    // Guarded by watchLock
+    static bool stopRequested;
+
+    // Held shared by operations, exclusively by checkpoint
+    static shared_mutex operations;
+
+    // Guards everything below
+    static mutex logLock;
+    static condition_variable synced;
+    // Entries appended but not yet written
+    static vector<char> pending;
+    static uint64_t lastLsn;
+    // Every entry up to it has had its write finished
+    static uint64_t writtenLsn;
+    // Every entry up to it is on disk
+    static uint64_t durableLsn;
+    // First and last LSN of each batch whose write failed
+    // since the last checkpoint
+    static vector<pair<uint64_t, uint64_t>> failedBatches;
+    // Set while a leader writes and syncs
+    static bool syncing;
+    // Set if a failed write could not be cut off the log;
+    // nothing more is written until a checkpoint empties it
+    static bool failed;
+    // Set once the log passes CHECKPOINT_BYTES
+    static bool checkpointDue;
+    // Bytes written since the last checkpoint
+    static size_t logBytes;
+    // Set if the log was not empty when opened
+    static bool leftOpen;
+    // Set while recover() replays entries
+    static bool replaying;
+
+    //*********************************************************
+    // checksumOf
+    //*********************************************************
+    // FNV-1a over an entry up to its checksum field.
+    //*********************************************************
+    static uint32_t checksumOf(const Entry &entry);
+
+    //*********************************************************
+    // checkpoint
+    //*********************************************************
+    // Syncs the .dat files and, if alone, empties the log,
+    // leaving a RUNNING entry in it unless the log is being
+    // closed.
+    //*********************************************************
+    static void checkpoint(bool stillRunning);
+
+    //*********************************************************
+    // writeRunning
+    //*********************************************************
+    // Writes and syncs a RUNNING entry. Called with logLock
+    // held and the log empty.
+    //*********************************************************
+    static void writeRunning();
+
+    //*********************************************************
+    // writeSynced
+    //*********************************************************
+    // Appends bytes to the log and syncs them. Whatever a
+    // failed write or sync added is cut off again.
+    // in: bytes, size
+    // out: true if written and synced; leftBehind - set if a
+    // failed write could not be cut off
+    //*********************************************************
+    static bool writeSynced(const char *bytes, size_t size,
+                            bool &leftBehind);
+
+    //*********************************************************
+    // watchLoop
+    //*********************************************************
+    // Body of the watcher thread: every WATCH_INTERVAL_MS,
+    // shares the live byte if a process is waiting to join,
+    // or takes it back once the others have gone.
+    //*********************************************************
+    static void watchLoop();
+
+    //*********************************************************
+    // stopWatcher
+    //*********************************************************
+    // Stops the watcher thread, if running.
+    //*********************************************************
+    static void stopWatcher();
+
+    //*********************************************************
+    // replay
+    //*********************************************************
+    // Applies one entry through the controls.
+    //*********************************************************
+    static void replay(const Entry &entry);
+
+    //*********************************************************
+    // syncFile
+    //*********************************************************
+    // Forces a data file's written pages to disk.
+    //*********************************************************
+    static void syncFile(const string &name);
+};
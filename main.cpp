@@ -5,10 +5,15 @@
 // Purpose: Main entry point for the FerryReserver application.
 // July 20, 2025 Version 2 - Darpandeep Kaur and Noble Sekhon
 // August 05, 2025 Version 3 -Noble Sekhon, Added Shutdown function call
+// Oct 17, 2026 Version 4 - Team 18, --server mode
 // ************************************************************
 
 #include "Util.h"
 #include "UI.h"
+#include "Server.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
 
 //************************************************************
 // Coding Convention for FerryReserver Project (CMPT 276 A3)
@@ -84,16 +89,42 @@ Comments:
 //************************************************************
 // Main entry point for the FerryReserver application.
 // This file initializes the system and starts the user interface
-// loop.
+// loop, or with --server <socket path> [--threads n] serves
+// clients over a Unix socket instead.
 //************************************************************
-int main()
+int main(int argc, char *argv[])
 {
+        std::string socketPath;
+        int threadCount = Server::DEFAULT_THREADS;
+
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+                std::string option = argv[i];
+                if (option == "--server")
+                {
+                        socketPath = argv[i + 1];
+                }
+                else if (option == "--threads")
+                {
+                        threadCount = std::atoi(argv[i + 1]);
+                }
+        }
 
         Util::startup();     // Initialize the system
-        UI::userInterface(); // Start the user interface loop
+
+        int status = 0;
+        if (!socketPath.empty())
+        {
+                // Serve clients until stopped by a signal
+                status = Server::run(socketPath, threadCount);
+        }
+        else
+        {
+                UI::userInterface(); // Start the user interface loop
+        }
 
         // shutdown the system after user quits the program
         Util::shutdown();
 
-        return 0; // Exit the application
-}
\ No newline at end of file
+        return status; // Exit the application
+}